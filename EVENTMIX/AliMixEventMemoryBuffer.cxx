@@ -0,0 +1,156 @@
+//
+// Class AliMixEventMemoryBuffer
+//
+// Ring buffers of (slimmed) events kept in memory per mixing bin
+//
+
+#include "AliLog.h"
+
+#include "AliMixEventMemoryBuffer.h"
+
+ClassImp(AliMixEventMemoryBuffer)
+
+//_________________________________________________________________________________________________
+AliMixEventMemoryBuffer::AliMixEventMemoryBuffer(Int_t depth, Long64_t maxBytes) : TObject(),
+   fDepth(depth > 0 ? depth : 1),
+   fMaxBytes(maxBytes > 0 ? maxBytes : 0),
+   fBytes(0),
+   fNEvents(0),
+   fSerial(0),
+   fNHits(0),
+   fNMisses(0),
+   fNEvicted(0),
+   fObjects(),
+   fEntries(),
+   fSizes(),
+   fSerials(),
+   fFirst(),
+   fN()
+{
+   //
+   // Default constructor.
+   //
+}
+
+//_________________________________________________________________________________________________
+AliMixEventMemoryBuffer::~AliMixEventMemoryBuffer()
+{
+   //
+   // Destructor
+   //
+   Clear();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::Clear(Option_t *)
+{
+   //
+   // Deletes all events
+   //
+   for (UInt_t i = 0; i < fObjects.size(); i++) delete fObjects[i];
+   fObjects.clear();
+   fEntries.clear();
+   fSizes.clear();
+   fSerials.clear();
+   fFirst.clear();
+   fN.clear();
+   fBytes = 0;
+   fNEvents = 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::Print(Option_t *) const
+{
+   //
+   // Prints buffer info
+   //
+   AliInfo(Form("bins=%d depth=%d events=%lld size=%lld bytes (limit %lld) hits=%lld misses=%lld evicted=%lld",
+                (Int_t) fN.size(), fDepth, fNEvents, fBytes, fMaxBytes, fNHits, fNMisses, fNEvicted));
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::Add(Int_t bin, Long64_t entry, TObject *obj, Long64_t bytes)
+{
+   //
+   // Adds event to bin. Oldest event in bin is removed when bin is full
+   // and oldest events of all bins are removed when memory limit is reached.
+   //
+   if (bin < 0 || !obj) {
+      delete obj;
+      return;
+   }
+   if (bin >= (Int_t) fN.size()) {
+      fObjects.resize((bin + 1) * fDepth, 0);
+      fEntries.resize((bin + 1) * fDepth, -1);
+      fSizes.resize((bin + 1) * fDepth, 0);
+      fSerials.resize((bin + 1) * fDepth, 0);
+      fFirst.resize(bin + 1, 0);
+      fN.resize(bin + 1, 0);
+   }
+   if (fN[bin] == fDepth) RemoveOldest(bin);
+   if (fMaxBytes > 0) {
+      while (fBytes + bytes > fMaxBytes && RemoveOldest()) fNEvicted++;
+   }
+
+   Int_t s = Slot(bin, fN[bin]);
+   fObjects[s] = obj;
+   fEntries[s] = entry;
+   fSizes[s] = bytes;
+   fSerials[s] = fSerial++;
+   fN[bin]++;
+   fBytes += bytes;
+   fNEvents++;
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventMemoryBuffer::Find(Int_t bin, Long64_t entry) const
+{
+   //
+   // Returns event with given entry in chain (0 if not in buffer)
+   //
+   if (bin >= 0 && bin < (Int_t) fN.size()) {
+      for (Int_t i = fN[bin] - 1; i >= 0; i--) {
+         Int_t s = Slot(bin, i);
+         if (fEntries[s] == entry) {
+            fNHits++;
+            return fObjects[s];
+         }
+      }
+   }
+   fNMisses++;
+   return 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventMemoryBuffer::RemoveOldest(Int_t bin)
+{
+   //
+   // Removes oldest event in bin
+   //
+   if (fN[bin] <= 0) return;
+   Int_t s = Slot(bin, 0);
+   delete fObjects[s];
+   fObjects[s] = 0;
+   fEntries[s] = -1;
+   fBytes -= fSizes[s];
+   fSizes[s] = 0;
+   fFirst[bin] = (fFirst[bin] + 1) % fDepth;
+   fN[bin]--;
+   fNEvents--;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventMemoryBuffer::RemoveOldest()
+{
+   //
+   // Removes oldest event of all bins
+   //
+   Int_t oldestBin = -1;
+   for (Int_t bin = 0; bin < (Int_t) fN.size(); bin++) {
+      if (fN[bin] <= 0) continue;
+      if (oldestBin < 0 || fSerials[Slot(bin, 0)] < fSerials[Slot(oldestBin, 0)]) oldestBin = bin;
+   }
+   if (oldestBin < 0) return kFALSE;
+   RemoveOldest(oldestBin);
+   return kTRUE;
+}
@@ -0,0 +1,65 @@
+//
+// Class AliMixEventMemoryBuffer
+//
+// Ring buffers of (slimmed) events kept in memory per mixing bin.
+// Every bin keeps the last "depth" events, identified by their entry
+// in the chain. When the total size exceeds the memory limit the
+// oldest events of all bins are removed.
+//
+
+#ifndef ALIMIXEVENTMEMORYBUFFER_H
+#define ALIMIXEVENTMEMORYBUFFER_H
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliMixEventMemoryBuffer : public TObject {
+public:
+   AliMixEventMemoryBuffer(Int_t depth = 1, Long64_t maxBytes = 0);
+   virtual ~AliMixEventMemoryBuffer();
+
+   virtual void      Clear(Option_t *option = "");
+   virtual void      Print(Option_t *option = "") const;
+
+   // adds event (buffer takes ownership)
+   void              Add(Int_t bin, Long64_t entry, TObject *obj, Long64_t bytes);
+   TObject          *Find(Int_t bin, Long64_t entry) const;
+
+   Int_t             GetDepth() const { return fDepth; }
+   Long64_t          GetMaxBytes() const { return fMaxBytes; }
+   Long64_t          GetBytes() const { return fBytes; }
+   Long64_t          GetNEvents() const { return fNEvents; }
+   Long64_t          GetNHits() const { return fNHits; }
+   Long64_t          GetNMisses() const { return fNMisses; }
+   Long64_t          GetNEvicted() const { return fNEvicted; }
+
+private:
+
+   Int_t             Slot(Int_t bin, Int_t i) const { return bin * fDepth + (fFirst[bin] + i) % fDepth; }
+   void              RemoveOldest(Int_t bin);
+   Bool_t            RemoveOldest();
+
+   Int_t             fDepth;        // number of events kept per bin
+   Long64_t          fMaxBytes;     // memory limit in bytes (0 = no limit)
+   Long64_t          fBytes;        //! current size in bytes
+   Long64_t          fNEvents;      //! number of events in buffer
+   Long64_t          fSerial;       //! insertion counter
+   mutable Long64_t  fNHits;        //! number of events found
+   mutable Long64_t  fNMisses;      //! number of events not found
+   Long64_t          fNEvicted;     //! number of events removed due to memory limit
+
+   std::vector<TObject *> fObjects; //! events (bin * fDepth + slot)
+   std::vector<Long64_t>  fEntries; //! entry in chain of events
+   std::vector<Long64_t>  fSizes;   //! size of events in bytes
+   std::vector<Long64_t>  fSerials; //! insertion number of events
+   std::vector<Int_t>     fFirst;   //! oldest slot in bin
+   std::vector<Int_t>     fN;       //! number of events in bin
+
+   AliMixEventMemoryBuffer(const AliMixEventMemoryBuffer &obj);
+   AliMixEventMemoryBuffer &operator=(const AliMixEventMemoryBuffer &obj);
+
+   ClassDef(AliMixEventMemoryBuffer, 1)
+};
+
+#endif
@@ -0,0 +1,69 @@
+//
+// Class AliMixEventSlimmer
+//
+// Produces the copy of an event which is kept in memory
+// by AliMixInputEventHandler for the in-memory mixing
+//
+
+#include <TClass.h>
+
+#include "AliLog.h"
+#include "AliESDEvent.h"
+#include "AliESDtrack.h"
+#include "AliESDv0.h"
+#include "AliESDcascade.h"
+#include "AliESDCaloCluster.h"
+#include "AliAODEvent.h"
+#include "AliAODTrack.h"
+#include "AliAODVertex.h"
+#include "AliAODv0.h"
+#include "AliAODcascade.h"
+#include "AliAODCaloCluster.h"
+
+#include "AliMixEventSlimmer.h"
+
+ClassImp(AliMixEventSlimmer)
+
+//_________________________________________________________________________________________________
+AliMixEventSlimmer::AliMixEventSlimmer(const char *name, const char *title) : TNamed(name, title)
+{
+   //
+   // Default constructor.
+   //
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventSlimmer::Slim(AliVEvent *ev, Long64_t &bytes) const
+{
+   //
+   // Full copy of the ESD/AOD event. The size is estimated
+   // from the number of the main objects in the event.
+   //
+   bytes = 0;
+   if (!ev) return 0;
+
+   AliAODEvent *aod = dynamic_cast<AliAODEvent *>(ev);
+   if (aod) {
+      bytes = sizeof(AliAODEvent)
+              + aod->GetNumberOfTracks() * sizeof(AliAODTrack)
+              + aod->GetNumberOfVertices() * sizeof(AliAODVertex)
+              + aod->GetNumberOfV0s() * sizeof(AliAODv0)
+              + aod->GetNumberOfCascades() * sizeof(AliAODcascade)
+              + aod->GetNumberOfCaloClusters() * sizeof(AliAODCaloCluster);
+      return new AliAODEvent(*aod);
+   }
+
+   AliESDEvent *esd = dynamic_cast<AliESDEvent *>(ev);
+   if (esd) {
+      bytes = sizeof(AliESDEvent)
+              + esd->GetNumberOfTracks() * sizeof(AliESDtrack)
+              + esd->GetNumberOfV0s() * sizeof(AliESDv0)
+              + esd->GetNumberOfCascades() * sizeof(AliESDcascade)
+              + esd->GetNumberOfCaloClusters() * sizeof(AliESDCaloCluster);
+      return new AliESDEvent(*esd);
+   }
+
+   AliWarning(Form("Event of type %s is copied with Clone(), size is not estimated", ev->ClassName()));
+   bytes = ev->IsA()->Size();
+   return ev->Clone();
+}
@@ -0,0 +1,29 @@
+//
+// Class AliMixEventSlimmer
+//
+// Produces the copy of an event which is kept in memory
+// by AliMixInputEventHandler for the in-memory mixing
+// (see AliMixInputEventHandler::SetMixInMemory()).
+// The default implementation copies the full ESD/AOD event.
+// Users can derive from it and return only what the mixing
+// needs (e.g. a TClonesArray of selected tracks).
+//
+
+#ifndef ALIMIXEVENTSLIMMER_H
+#define ALIMIXEVENTSLIMMER_H
+
+#include <TNamed.h>
+
+class AliVEvent;
+class AliMixEventSlimmer : public TNamed {
+public:
+   AliMixEventSlimmer(const char *name = "mixEventSlimmer", const char *title = "Mix event slimmer");
+   virtual ~AliMixEventSlimmer() {}
+
+   // returns new object owned by caller and sets its (approximate) size in bytes
+   virtual TObject  *Slim(AliVEvent *ev, Long64_t &bytes) const;
+
+   ClassDef(AliMixEventSlimmer, 1)
+};
+
+#endif
@@ -17,6 +17,8 @@
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventMemoryBuffer.h"
+#include "AliMixEventSlimmer.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -43,7 +45,14 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fMixInMemory(kFALSE),
+   fMixInMemoryMaxBytes(0),
+   fMixEventSlimmer(0),
+   fMixEventMemoryBuffer(0),
+   fMemoryBin(-1),
+   fMemoryEntry(-1),
+   fMixedEvents()
 {
    //
    // Default constructor.
@@ -59,6 +68,11 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   if (fMixEventMemoryBuffer) AliDebug(AliLog::kDebug, Form("Memory buffer: events=%lld hits=%lld misses=%lld evicted=%lld",
+                                          fMixEventMemoryBuffer->GetNEvents(), fMixEventMemoryBuffer->GetNHits(),
+                                          fMixEventMemoryBuffer->GetNMisses(), fMixEventMemoryBuffer->GetNEvicted()));
+   delete fMixEventMemoryBuffer;
+   delete fMixEventSlimmer;
 }
 
 //_____________________________________________________________________________
@@ -97,6 +111,19 @@ Bool_t AliMixInputEventHandler::Init(TTree *tree, Option_t *opt)
       AliWarning("fDoMixIfNotEnoughEvents=kFALSE -> setting fDoMixExtra=kFALSE");
    }
 
+   // creates memory buffer for in-memory mixing, it keeps as many events
+   // per bin as the mixing methods can request
+   if (fMixInMemory && !fMixEventMemoryBuffer) {
+      Int_t depth = fMixNumber;
+      if (fBufferSize > 1) depth = fBufferSize;
+      else if (fDoMixExtra) depth = 2 * fMixNumber + 2;
+      fMixEventMemoryBuffer = new AliMixEventMemoryBuffer(depth, fMixInMemoryMaxBytes);
+      if (!fMixEventSlimmer) fMixEventSlimmer = new AliMixEventSlimmer();
+      AliInfo(Form("Mixing in memory with %d events per bin (memory limit %lld bytes)", depth, fMixInMemoryMaxBytes));
+      AliInfo("Input handlers are prepared only for mixed events not found in memory, "
+              "tasks have to use GetMixedEvent() or GetEntryMixedEvent()");
+   }
+
    // clears array of input handlers
    fMixTrees.Delete();
    // create AliMixInputHandlerInfo
@@ -192,6 +219,9 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
+   fMemoryBin = -1;
+   fMixedEvents.Clear();
+
    if (!fEventPool) {
       MixStd();
    }
@@ -206,6 +236,9 @@ Bool_t AliMixInputEventHandler::GetEntry()
       AliWarning("Not supported Mixing !!!");
    }
 
+   // current main event is available for mixing with next events
+   if (fMixEventMemoryBuffer && fMemoryBin >= 0) StoreMainEvent();
+
    AliDebug(AliLog::kDebug + 5, Form("->"));
    return kTRUE;
 }
@@ -229,6 +262,9 @@ Bool_t AliMixInputEventHandler::MixStd()
    // check for PhysSelection
    if (!IsEventCurrentSelected()) return kFALSE;
 
+   fMemoryBin = 0;
+   fMemoryEntry = fEntryCounter;
+
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -258,7 +294,7 @@ Bool_t AliMixInputEventHandler::MixStd()
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         PrepareMixedEvent(0, entryMixReal, entryMix, te, mihi);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, 1, fEntryCounter, entryMixReal, fNumberMixed);
@@ -307,6 +343,10 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    TEntryList *el = 0;
    Int_t idEntryList = -1;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   if (el) {
+      fMemoryBin = idEntryList;
+      fMemoryEntry = currentMainEntry;
+   }
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -355,7 +395,7 @@ Bool_t AliMixInputEventHandler::MixBuffer()
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
          AliDebug(AliLog::kDebug + 3, Form("Preparing InputEventHandler(%d)", counter));
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(counter), fAnalysisType);
+         PrepareMixedEvent(counter, entryMixReal, entryMix, te, mihi);
          fNumberMixed++;
       }
       counter++;
@@ -407,6 +447,10 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Int_t idEntryList = -1;
    TEntryList *el = 0;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   if (el) {
+      fMemoryBin = idEntryList;
+      fMemoryEntry = currentMainEntry;
+   }
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       // runs UserExecMix for all tasks, if needed
@@ -471,7 +515,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
          AliError("te is null. this is error. tell to developer (#2)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         PrepareMixedEvent(0, entryMixReal, entryMix, te, mihi);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
@@ -621,7 +665,71 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
       AliError(Form("GetEntryMixedEvent(%d) => entryMix<0 [2]",id));
       return kFALSE;
    }
+   // in case of in-memory mixing the mixing loop prepares the input handler
+   // only for events not found in memory
    mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(id), fAnalysisType);
 
    return kTRUE;
 }
+
+//_____________________________________________________________________________
+TObject *AliMixInputEventHandler::GetMixedEventObject(Int_t id) {
+   //
+   // Returns mixed event for input handler with id. In case of in-memory
+   // mixing it is the copy created by AliMixEventSlimmer, otherwise
+   // the event of the input handler (Should be used in UserExecMix() only)
+   //
+
+   if (!fMixEventMemoryBuffer) {
+      AliInputEventHandler *ih = dynamic_cast<AliInputEventHandler *>(InputEventHandler(id));
+      return ih ? ih->GetEvent() : 0;
+   }
+   if (id < 0 || id >= fMixedEvents.GetSize()) return 0;
+   return fMixedEvents.UncheckedAt(id);
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::PrepareMixedEvent(Int_t id, Long64_t entryMixReal, Long64_t entryMix, TChainElement *te, AliMixInputHandlerInfo *mihi)
+{
+   //
+   // Prepares mixed event for input handler with id. entryMixReal is the entry
+   // in the full chain (key of the memory buffer), entryMix the entry in tree te.
+   // In case of in-memory mixing GetMixedEvent(id) returns the copy from memory
+   // buffer and the event is read from chain only when it is not there (removed
+   // due to memory limit), then GetMixedEvent(id) returns the event of the input
+   // handler. The input handler is not prepared when the event is found in
+   // memory, tasks reading InputEventHandler(id)->GetEvent() have to call
+   // GetEntryMixedEvent(id) in that case.
+   //
+   AliInputEventHandler *ih = (AliInputEventHandler *)InputEventHandler(id);
+   if (!fMixEventMemoryBuffer) {
+      if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, ih, fAnalysisType);
+      return;
+   }
+
+   TObject *obj = fMixEventMemoryBuffer->Find(fMemoryBin, entryMixReal);
+   if (!obj) {
+      AliDebug(AliLog::kDebug + 3, Form("Entry %lld not in memory, reading it from chain", entryMixReal));
+      mihi->PrepareEntry(te, entryMix, ih, fAnalysisType);
+      obj = ih->GetEvent();
+   }
+   fMixedEvents.AddAtAndExpand(obj, id);
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::StoreMainEvent()
+{
+   //
+   // Stores copy of current main event in memory buffer
+   //
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return;
+
+   Long64_t bytes = 0;
+   TObject *obj = fMixEventSlimmer->Slim(inEvHMain->GetEvent(), bytes);
+   fMixEventMemoryBuffer->Add(fMemoryBin, fMemoryEntry, obj, bytes);
+}
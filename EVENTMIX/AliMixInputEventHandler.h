@@ -21,6 +21,8 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventMemoryBuffer;
+class AliMixEventSlimmer;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -73,6 +75,17 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // in-memory mixing: GetMixedEvent() returns copies kept in memory instead of events
+   // read again from chain (maxBytes = 0 means no memory limit). Input handlers are
+   // prepared only for events not found in memory, tasks reading
+   // InputEventHandler(id)->GetEvent() have to call GetEntryMixedEvent(id)
+   void                    SetMixInMemory(Bool_t b = kTRUE, Long64_t maxBytes = 0) { fMixInMemory = b; fMixInMemoryMaxBytes = maxBytes; }
+   void                    SetMixEventSlimmer(AliMixEventSlimmer *slimmer) { fMixEventSlimmer = slimmer; }
+   Bool_t                  IsMixInMemory() const { return fMixInMemory; }
+   AliMixEventMemoryBuffer *GetMixEventMemoryBuffer() const { return fMixEventMemoryBuffer; }
+   TObject                *GetMixedEventObject(Int_t idHandler=0);
+   AliVEvent              *GetMixedEvent(Int_t idHandler=0) { return dynamic_cast<AliVEvent *>(GetMixedEventObject(idHandler)); }
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -100,17 +113,27 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   Bool_t                   fMixInMemory;          // mix events kept in memory
+   Long64_t                 fMixInMemoryMaxBytes;  // memory limit for in-memory mixing (0 = no limit)
+   AliMixEventSlimmer      *fMixEventSlimmer;      // creates copies of events kept in memory
+   AliMixEventMemoryBuffer *fMixEventMemoryBuffer; //! events kept in memory
+   Int_t                    fMemoryBin;            //! bin of current main event in memory buffer (-1 = not stored)
+   Long64_t                 fMemoryEntry;          //! entry of current main event in memory buffer
+   TObjArray                fMixedEvents;          //! current mixed events (in-memory mixing)
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
 
+   void                    PrepareMixedEvent(Int_t id, Long64_t entryMixReal, Long64_t entryMix, TChainElement *te, AliMixInputHandlerInfo *mihi);
+   void                    StoreMainEvent();
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -2,6 +2,8 @@
 
 #pragma link C++ class AliMixEventCutObj+;
 #pragma link C++ class AliMixEventPool+;
+#pragma link C++ class AliMixEventMemoryBuffer+;
+#pragma link C++ class AliMixEventSlimmer+;
 
 #pragma link C++ class AliMixInfo+;
 #pragma link C++ class AliMixInputHandlerInfo+;
@@ -66,6 +66,9 @@
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
 #include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <cctype>
 
 #include <Riostream.h>
 #include <TH1F.h>
@@ -111,6 +114,232 @@
 
 class StringToRegexp : public std::map<std::string, TPRegexp> {};
 
+namespace {
+  // reads a number from a trigger string, stops at the next space
+  Int_t ParseTriggerNumber(const char*& str) {
+    Int_t ret = 0;
+    while (*str && *str != ' ')
+      ret = 10 * ret + (*str++ - '0');
+    return ret;
+  }
+}
+
+// Trigger logic (e.g. "V0A && V0C && !TPCHVdip") compiled into a small stack
+// program. Supported are the operators || && == != < <= > >= !, parentheses,
+// numbers and trigger tokens; the tokens are numbered in the same order as the
+// parameters of the TFormula. If a logic cannot be compiled, or the program
+// does not give the same result as the TFormula for a set of test values,
+// the TFormula is used.
+class TriggerLogicProgram {
+public:
+  enum EOp { kConst, kParam, kNot, kOr, kAnd, kEq, kNe, kLt, kLe, kGt, kGe };
+  enum { kMaxDepth = 64 };
+
+  TriggerLogicProgram() : fFormulaAndBits(0), fOps(), fValues(), fParams(), fNParams(0), fCompiled(kFALSE) {}
+
+  Bool_t Compile(const char* logic);
+  Double_t Eval(const Double_t* params) const;
+
+  FormulaAndBits* fFormulaAndBits; // TFormula and trigger bits of the parameters
+  std::vector<Int_t> fOps;         // program
+  std::vector<Double_t> fValues;   // constant or parameter index for each op
+  std::vector<Double_t> fParams;   // parameters of the current evaluation
+  Int_t fNParams;                  // number of trigger tokens
+  Bool_t fCompiled;                // program can be used instead of the TFormula
+
+private:
+  Bool_t ParseOr(const char*& s, Int_t& nParams);
+  Bool_t ParseAnd(const char*& s, Int_t& nParams);
+  Bool_t ParseEquality(const char*& s, Int_t& nParams);
+  Bool_t ParseRelation(const char*& s, Int_t& nParams);
+  Bool_t ParseUnary(const char*& s, Int_t& nParams);
+  Bool_t ParsePrimary(const char*& s, Int_t& nParams);
+  void Emit(Int_t op, Double_t value = 0) { fOps.push_back(op); fValues.push_back(value); }
+  static void SkipSpaces(const char*& s) { while (*s == ' ' || *s == '\t') s++; }
+  static Bool_t Accept(const char*& s, const char* op);
+};
+
+Bool_t TriggerLogicProgram::Accept(const char*& s, const char* op) {
+  SkipSpaces(s);
+  size_t n = strlen(op);
+  if (strncmp(s, op, n)) return kFALSE;
+  // do not take the '<' of "<=" or the '!' of "!="
+  if (n == 1 && (op[0] == '<' || op[0] == '>' || op[0] == '!') && s[1] == '=') return kFALSE;
+  s += n;
+  return kTRUE;
+}
+
+Bool_t TriggerLogicProgram::ParseOr(const char*& s, Int_t& nParams) {
+  if (!ParseAnd(s, nParams)) return kFALSE;
+  while (Accept(s, "||")) {
+    if (!ParseAnd(s, nParams)) return kFALSE;
+    Emit(kOr);
+  }
+  return kTRUE;
+}
+
+Bool_t TriggerLogicProgram::ParseAnd(const char*& s, Int_t& nParams) {
+  if (!ParseEquality(s, nParams)) return kFALSE;
+  while (Accept(s, "&&")) {
+    if (!ParseEquality(s, nParams)) return kFALSE;
+    Emit(kAnd);
+  }
+  return kTRUE;
+}
+
+Bool_t TriggerLogicProgram::ParseEquality(const char*& s, Int_t& nParams) {
+  if (!ParseRelation(s, nParams)) return kFALSE;
+  while (kTRUE) {
+    Int_t op = -1;
+    if (Accept(s, "==")) op = kEq;
+    else if (Accept(s, "!=")) op = kNe;
+    else break;
+    if (!ParseRelation(s, nParams)) return kFALSE;
+    Emit(op);
+  }
+  return kTRUE;
+}
+
+Bool_t TriggerLogicProgram::ParseRelation(const char*& s, Int_t& nParams) {
+  if (!ParseUnary(s, nParams)) return kFALSE;
+  while (kTRUE) {
+    Int_t op = -1;
+    if (Accept(s, "<=")) op = kLe;
+    else if (Accept(s, ">=")) op = kGe;
+    else if (Accept(s, "<")) op = kLt;
+    else if (Accept(s, ">")) op = kGt;
+    else break;
+    if (!ParseUnary(s, nParams)) return kFALSE;
+    Emit(op);
+  }
+  return kTRUE;
+}
+
+Bool_t TriggerLogicProgram::ParseUnary(const char*& s, Int_t& nParams) {
+  if (Accept(s, "!")) {
+    if (!ParseUnary(s, nParams)) return kFALSE;
+    Emit(kNot);
+    return kTRUE;
+  }
+  return ParsePrimary(s, nParams);
+}
+
+Bool_t TriggerLogicProgram::ParsePrimary(const char*& s, Int_t& nParams) {
+  SkipSpaces(s);
+  if (*s == '(') {
+    s++;
+    if (!ParseOr(s, nParams)) return kFALSE;
+    return Accept(s, ")");
+  }
+  if (isalpha(*s)) {
+    // same tokens as the regexp [[:alpha:]][[:alnum:]]* used for the TFormula
+    while (isalnum(*s)) s++;
+    Emit(kParam, nParams++);
+    return kTRUE;
+  }
+  if (isdigit(*s)) {
+    Double_t value = 0;
+    while (isdigit(*s)) value = 10 * value + (*s++ - '0');
+    if (isalpha(*s) || *s == '.') return kFALSE;
+    Emit(kConst, value);
+    return kTRUE;
+  }
+  return kFALSE;
+}
+
+Bool_t TriggerLogicProgram::Compile(const char* logic) {
+  fOps.clear();
+  fValues.clear();
+  fCompiled = kFALSE;
+
+  const char* s = logic;
+  Int_t nParams = 0;
+  if (!ParseOr(s, nParams)) return kFALSE;
+  SkipSpaces(s);
+  if (*s) return kFALSE;
+
+  Int_t depth = 0;
+  for (size_t i = 0; i < fOps.size(); i++) {
+    depth += (fOps[i] == kConst || fOps[i] == kParam) ? 1 : (fOps[i] == kNot ? 0 : -1);
+    if (depth > kMaxDepth) return kFALSE;
+  }
+
+  fNParams = nParams;
+  fCompiled = kTRUE;
+  return kTRUE;
+}
+
+Double_t TriggerLogicProgram::Eval(const Double_t* params) const {
+  Double_t stack[kMaxDepth];
+  Int_t n = 0;
+  for (size_t i = 0; i < fOps.size(); i++) {
+    switch (fOps[i]) {
+      case kConst: stack[n++] = fValues[i]; break;
+      case kParam: stack[n++] = params[(Int_t) fValues[i]]; break;
+      case kNot:   stack[n-1] = (stack[n-1] == 0); break;
+      case kOr:    n--; stack[n-1] = (stack[n-1] != 0 || stack[n] != 0); break;
+      case kAnd:   n--; stack[n-1] = (stack[n-1] != 0 && stack[n] != 0); break;
+      case kEq:    n--; stack[n-1] = (stack[n-1] == stack[n]); break;
+      case kNe:    n--; stack[n-1] = (stack[n-1] != stack[n]); break;
+      case kLt:    n--; stack[n-1] = (stack[n-1] <  stack[n]); break;
+      case kLe:    n--; stack[n-1] = (stack[n-1] <= stack[n]); break;
+      case kGt:    n--; stack[n-1] = (stack[n-1] >  stack[n]); break;
+      case kGe:    n--; stack[n-1] = (stack[n-1] >= stack[n]); break;
+    }
+  }
+  return stack[0];
+}
+
+class StringToProgram : public std::map<std::string, TriggerLogicProgram> {};
+
+// Trigger classes of the physics selection compiled for the current run.
+// Each distinct +/- token becomes a pattern; the patterns are matched once for
+// every distinct string of fired trigger classes (cached for the run), such
+// that the requirement of a trigger class is a test of bit masks.
+class TriggerClassMatcher {
+public:
+  enum { kMaxCachedClasses = 4096 };
+
+  struct Entry {
+    Entry() : fRequired(), fRejected(), fBCs(), fReturnCode(AliVEvent::kUserDefined), fTriggerLogic(0), fOnline(0), fOffline(0) {}
+    std::vector<UInt_t> fRequired;   // patterns which have to match
+    std::vector<UInt_t> fRejected;   // patterns which must not match
+    std::vector<Int_t> fBCs;         // accepted bunch crossings (none = all)
+    UInt_t fReturnCode;              // offline trigger bit of the class
+    Int_t fTriggerLogic;             // index of online/offline trigger logic
+    TriggerLogicProgram* fOnline;    // online trigger logic (set on first use)
+    TriggerLogicProgram* fOffline;   // offline trigger logic (set on first use)
+  };
+
+  TriggerClassMatcher() : fPatterns(), fPatternIndex(), fEntries(), fMatched(), fDecision(), fDecisionEvent(), fEvent(0) {}
+
+  void Clear() { fPatterns.clear(); fPatternIndex.clear(); fEntries.clear(); fMatched.clear(); }
+  Int_t NWords() const { return (fPatterns.size() + 31) / 32; }
+  const std::vector<UInt_t>& Match(const TString& classes);
+
+  std::vector<TPRegexp*> fPatterns;                 // distinct patterns of all classes
+  std::map<std::string, Int_t> fPatternIndex;      // pattern string -> index
+  std::vector<Entry> fEntries;                      // fCollTrigClasses followed by fBGTrigClasses
+  std::unordered_map<std::string, std::vector<UInt_t> > fMatched; // fired classes -> matched patterns
+  std::vector<Int_t> fDecision;                     // trigger decisions of the current event
+  std::vector<ULong64_t> fDecisionEvent;            // event for which the decision is valid
+  ULong64_t fEvent;                                 // event counter
+};
+
+const std::vector<UInt_t>& TriggerClassMatcher::Match(const TString& classes) {
+  std::string key(classes.Data(), classes.Length());
+  auto it = fMatched.find(key);
+  if (it != fMatched.end())
+    return it->second;
+
+  if (fMatched.size() >= kMaxCachedClasses) fMatched.clear();
+  std::vector<UInt_t> matched(NWords(), 0);
+  for (size_t i = 0; i < fPatterns.size(); i++)
+    if (fPatterns[i]->Match(classes, "", 0, 1))
+      matched[i / 32] |= 1u << (i % 32);
+  return fMatched.emplace(key, std::move(matched)).first->second;
+}
+
 ClassImp(AliPhysicsSelection)
 
 AliPhysicsSelection::AliPhysicsSelection() :
@@ -123,6 +352,7 @@ fIsPP(kFALSE),
 fReadOCDB(kFALSE),
 fUseBXNumbers(0),
 fUsingCustomClasses(0),
+fShareTriggerDecisions(kFALSE),
 fCollTrigClasses(),
 fBGTrigClasses(),
 fTriggerAnalysis(),
@@ -132,7 +362,9 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fTriggerToFormula(new StringToFormula()),
-fTriggerToRegexp(new StringToRegexp())
+fTriggerToRegexp(new StringToRegexp()),
+fTriggerToProgram(new StringToProgram()),
+fTriggerClassMatcher(new TriggerClassMatcher())
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -153,6 +385,7 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fReadOCDB(kFALSE),
  fUseBXNumbers(0),
  fUsingCustomClasses(0),
+ fShareTriggerDecisions(kFALSE),
  fCollTrigClasses(),
  fBGTrigClasses(),
  fTriggerAnalysis(),
@@ -162,7 +395,9 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fFillOADB(0),
  fTriggerOADB(0),
  fTriggerToFormula(new StringToFormula()),
- fTriggerToRegexp(new StringToRegexp())
+ fTriggerToRegexp(new StringToRegexp()),
+ fTriggerToProgram(new StringToProgram()),
+ fTriggerClassMatcher(new TriggerClassMatcher())
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -179,6 +414,8 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fTriggerToFormula;
   delete fTriggerToRegexp;
+  delete fTriggerToProgram;
+  delete fTriggerClassMatcher;
 }
 
 UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
@@ -199,15 +436,6 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
 
   AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", classes.Data()));
 
-  struct Util {
-    static Int_t atoi(const char*& str) {
-      Int_t ret = 0;
-      while (*str && *str != ' ')
-        ret = 10 * ret + (*str++ - '0');
-      return ret;
-    }
-  };
-
   std::string str;
   while (true) {
     // finished
@@ -234,19 +462,19 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
     if (*trigger == '#') {
       foundBCRequirement = kTRUE;
 
-      if (event->GetBunchCrossNumber() == Util::atoi(++trigger))
+      if (event->GetBunchCrossNumber() == ParseTriggerNumber(++trigger))
         foundCorrectBC = kTRUE;
 
       continue;
     }
     // return value
     if (*trigger == '&') {
-      returnCode = Util::atoi(++trigger);
+      returnCode = ParseTriggerNumber(++trigger);
       continue;
     }
     // triggerLogic value
     if (*trigger == '*') {
-      triggerLogicLocal = Util::atoi(++trigger);
+      triggerLogicLocal = ParseTriggerNumber(++trigger);
       continue;
     }
 
@@ -259,6 +487,92 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
   return returnCode;
 }
 
+UInt_t AliPhysicsSelection::CheckCompiledTriggerClass(const AliVEvent* event, const std::vector<UInt_t>& matched, Int_t i, Int_t& triggerLogic) const {
+  // same as CheckTriggerClass for the i-th trigger class of CompileTriggerClasses(),
+  // matched are the patterns found in the fired trigger classes of the event
+
+  const TriggerClassMatcher::Entry& entry = fTriggerClassMatcher->fEntries[i];
+  for (size_t w = 0; w < matched.size(); w++) {
+    if ((matched[w] & entry.fRequired[w]) != entry.fRequired[w]) return kFALSE;
+    if (matched[w] & entry.fRejected[w]) return kFALSE;
+  }
+
+  if (!entry.fBCs.empty()) {
+    Int_t bc = event->GetBunchCrossNumber();
+    Bool_t foundCorrectBC = kFALSE;
+    for (size_t k = 0; k < entry.fBCs.size() && !foundCorrectBC; k++)
+      foundCorrectBC = (bc == entry.fBCs[k]);
+    if (!foundCorrectBC) return kFALSE;
+  }
+
+  triggerLogic = entry.fTriggerLogic;
+  return entry.fReturnCode;
+}
+
+void AliPhysicsSelection::CompileTriggerClasses() {
+  // parses the collision and background trigger classes (format see CheckTriggerClass)
+  // into bit masks of distinct trigger patterns, done once per run
+
+  TriggerClassMatcher& matcher = *fTriggerClassMatcher;
+  matcher.Clear();
+
+  Int_t nColl = fCollTrigClasses.GetEntries();
+  Int_t nBG   = fBGTrigClasses.GetEntries();
+  std::vector<std::vector<std::pair<Int_t, Int_t> > > tokens(nColl + nBG);
+  matcher.fEntries.resize(nColl + nBG);
+
+  std::string str;
+  for (Int_t i=0; i<nColl+nBG; i++) {
+    const char* trigger = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
+    TriggerClassMatcher::Entry& entry = matcher.fEntries[i];
+    while (*trigger) {
+      if (*trigger == '+' || *trigger == '-') {
+        Int_t flag = (*trigger == '+');
+        trigger++;
+        const char* begin = trigger;
+        while (*trigger && *trigger != ' ')
+          trigger++;
+        str.assign(begin, trigger);
+
+        auto it = matcher.fPatternIndex.find(str);
+        if (it == matcher.fPatternIndex.end()) {
+          it = matcher.fPatternIndex.emplace(str, (Int_t) matcher.fPatterns.size()).first;
+          matcher.fPatterns.push_back(&FindRegexp(str));
+        }
+        tokens[i].push_back(std::make_pair(it->second, flag));
+        continue;
+      }
+      if (*trigger == '#') {
+        entry.fBCs.push_back(ParseTriggerNumber(++trigger));
+        continue;
+      }
+      if (*trigger == '&') {
+        entry.fReturnCode = ParseTriggerNumber(++trigger);
+        continue;
+      }
+      if (*trigger == '*') {
+        entry.fTriggerLogic = ParseTriggerNumber(++trigger);
+        continue;
+      }
+      trigger++;
+    }
+  }
+
+  for (Int_t i=0; i<nColl+nBG; i++) {
+    TriggerClassMatcher::Entry& entry = matcher.fEntries[i];
+    entry.fRequired.assign(matcher.NWords(), 0);
+    entry.fRejected.assign(matcher.NWords(), 0);
+    for (size_t k = 0; k < tokens[i].size(); k++) {
+      Int_t index = tokens[i][k].first;
+      UInt_t bit = 1u << (index % 32);
+      if (tokens[i][k].second) entry.fRequired[index / 32] |= bit;
+      else                     entry.fRejected[index / 32] |= bit;
+    }
+  }
+
+  AliInfo(Form("Compiled %d trigger classes with %d distinct patterns", nColl + nBG, (Int_t) matcher.fPatterns.size()));
+}
+
 /// Evaluate if the given event fulfills a given trigger logic
 ///
 /// \param event Pointer to the current event
@@ -270,18 +584,46 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
 Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event,
 						 AliTriggerAnalysis* triggerAnalysis,
 						 const char* triggerLogic, Bool_t offline){
-  auto& formula_and_bits = FindForumla(triggerLogic);
-  auto& trg_formula = formula_and_bits.first;
-  auto& bits = formula_and_bits.second;
+  return EvaluateTriggerLogic(event, triggerAnalysis, FindProgram(triggerLogic), offline);
+}
+
+/// Evaluate if the given event fulfills a given compiled trigger logic
+///
+/// \param event Pointer to the current event
+/// \param triggerAnalysis Pointer to the TriggerAnlysis class
+/// \param program Trigger logic from FindProgram()
+/// \param offline Offline analysis(?)
+///
+/// \return True if the given event matches the trigger logic
+Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event,
+						 AliTriggerAnalysis* triggerAnalysis,
+						 TriggerLogicProgram& program, Bool_t offline){
+  auto& trg_formula = program.fFormulaAndBits->first;
+  auto& bits = program.fFormulaAndBits->second;
   // Get the values for each individual trigger in the trigger logic string;
   // These values are the parameters of the TFormula
-  std::vector<Double_t> paras(bits.size());
+  std::vector<Double_t>& paras = program.fParams;
+  paras.resize(bits.size());
   auto offline_flag = offline ? AliTriggerAnalysis::kOfflineFlag : 0;
+  TriggerClassMatcher& matcher = *fTriggerClassMatcher;
+  Bool_t share = fShareTriggerDecisions && !matcher.fDecision.empty();
   for (size_t i = 0; i < bits.size(); ++i) {
     typedef AliTriggerAnalysis::Trigger Trigger;
     Trigger bit = static_cast<Trigger>(bits[i] | offline_flag);
-    paras[i] = triggerAnalysis->EvaluateTrigger(event, bit);
+    if (!share || bits[i] >= AliTriggerAnalysis::kStartOfFlags) {
+      paras[i] = triggerAnalysis->EvaluateTrigger(event, bit);
+      continue;
+    }
+    // decision of this event may be already evaluated for another trigger class
+    size_t index = bits[i] + (offline ? AliTriggerAnalysis::kStartOfFlags : 0);
+    if (matcher.fDecisionEvent[index] != matcher.fEvent) {
+      matcher.fDecision[index] = triggerAnalysis->EvaluateTrigger(event, bit);
+      matcher.fDecisionEvent[index] = matcher.fEvent;
+    }
+    paras[i] = matcher.fDecision[index];
   }
+  if (program.fCompiled)
+    return program.Eval(paras.data());
   Double_t dummy_val[] = {0};
   return trg_formula.EvalPar(dummy_val, paras.data());
 }
@@ -305,6 +647,14 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
+  if ((Int_t) fTriggerClassMatcher->fEntries.size() != nColl+nBG) CompileTriggerClasses();
+
+  // fired trigger classes are matched once per event against the patterns of all classes
+  TString classes = event->GetFiredTriggerClasses();
+  AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", classes.Data()));
+  const std::vector<UInt_t>& matched = fTriggerClassMatcher->Match(classes);
+  fTriggerClassMatcher->fEvent++;
+
   for (Int_t i=0; i<nColl+nBG; i++) {
     const char* triggerClass = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
     AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", triggerClass));
@@ -313,10 +663,13 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     triggerAnalysis->FillTriggerClasses(event);
     
     Int_t triggerLogic = 0;
-    UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
+    UInt_t singleTriggerResult = CheckCompiledTriggerClass(event, matched, i, triggerLogic);
     if (!singleTriggerResult) continue;
-    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
-    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
+    TriggerClassMatcher::Entry& entry = fTriggerClassMatcher->fEntries[i];
+    if (!entry.fOnline)  entry.fOnline  = &FindProgram(fPSOADB->GetHardwareTrigger(triggerLogic));
+    if (!entry.fOffline) entry.fOffline = &FindProgram(fPSOADB->GetOfflineTrigger(triggerLogic));
+    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, *entry.fOnline, kFALSE);
+    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, *entry.fOffline, kTRUE);
     triggerAnalysis->FillHistograms(event,onlineDecision,offlineDecision);
     if (!onlineDecision) continue;
     if (!offlineDecision) continue;
@@ -488,6 +841,11 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
   
   fCurrentRun = runNumber;
 
+  // trigger classes and the cache of fired classes are per run
+  CompileTriggerClasses();
+  fTriggerClassMatcher->fDecision.assign(2 * AliTriggerAnalysis::kStartOfFlags, 0);
+  fTriggerClassMatcher->fDecisionEvent.assign(2 * AliTriggerAnalysis::kStartOfFlags, 0);
+
   TH1::AddDirectory(oldStatus);
   return kTRUE;
 }
@@ -876,6 +1234,39 @@ FormulaAndBits& AliPhysicsSelection::FindForumla(const char* triggerLogic) {
   return it->second;
 }
 
+TriggerLogicProgram& AliPhysicsSelection::FindProgram(const char* triggerLogic) {
+  // Returns the compiled trigger logic, set up on first use
+  auto it = fTriggerToProgram->find(triggerLogic);
+  if (it != fTriggerToProgram->end())
+    return it->second;
+
+  TriggerLogicProgram& program = (*fTriggerToProgram)[triggerLogic];
+  program.fFormulaAndBits = &FindForumla(triggerLogic);
+  R5TFormula& formula = program.fFormulaAndBits->first;
+  Int_t nParams = program.fFormulaAndBits->second.size();
+  if (!program.Compile(triggerLogic) || program.fNParams != nParams) {
+    program.fCompiled = kFALSE;
+    AliInfo(Form("Trigger logic \"%s\" is evaluated with TFormula", triggerLogic));
+    return program;
+  }
+
+  // check the program against the TFormula: all 0/1 combinations of up to
+  // 12 parameters and a set of larger values
+  std::vector<Double_t> paras(nParams + 1, 0);
+  Double_t dummy_val[] = {0};
+  const Double_t values[] = {0, 1, 2, 3, 5, 10, 20, 100};
+  Int_t nCombinations = nParams <= 12 ? (1 << nParams) : 4096;
+  for (Int_t t = 0; t < nCombinations + 64 && program.fCompiled; t++) {
+    for (Int_t i = 0; i < nParams; i++)
+      paras[i] = t < nCombinations ? ((t >> (i % 12)) & 1) : values[(7 * t + 3 * i) % 8];
+    if ((program.Eval(paras.data()) != 0) != (formula.EvalPar(dummy_val, paras.data()) != 0)) {
+      AliWarning(Form("Compiled trigger logic \"%s\" differs from TFormula, using TFormula", triggerLogic));
+      program.fCompiled = kFALSE;
+    }
+  }
+  return program;
+}
+
 TPRegexp& AliPhysicsSelection::FindRegexp(const std::string& triggers) const {
   auto it = fTriggerToRegexp->find(triggers);
   if (it != fTriggerToRegexp->end())
@@ -45,6 +45,9 @@ class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
 class TPRegexp;
 class StringToRegexp;
+class StringToProgram;
+class TriggerLogicProgram;
+class TriggerClassMatcher;
 
 typedef std::pair<R5TFormula, std::vector<AliTriggerAnalysis::Trigger>> FormulaAndBits;
 typedef std::map<std::string, FormulaAndBits> StringToFormula;
@@ -99,9 +102,15 @@ public:
   void DetectPassName();
   void ReadOCDB(Bool_t val) { fReadOCDB=val; }
   Bool_t IsMC() const { return fMC; }
+  // Evaluate each trigger of the trigger logic only once per event and share the result between
+  // the AliTriggerAnalysis objects. Only valid if all of them have the same settings.
+  void SetShareTriggerDecisions(Bool_t val = kTRUE) { fShareTriggerDecisions = val; }
 protected:
   UInt_t CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const;
+  UInt_t CheckCompiledTriggerClass(const AliVEvent* event, const std::vector<UInt_t>& matched, Int_t i, Int_t& triggerLogic) const;
+  void   CompileTriggerClasses();
   Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
+  Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, TriggerLogicProgram& program, Bool_t offline);
   const char * GetTriggerString(TObjString * obj);
 
   TString fPassName;          // pass name for current run
@@ -112,6 +121,7 @@ protected:
   Bool_t fReadOCDB;           // Flag to read thresholds from OCDB
   Bool_t fUseBXNumbers;       // Explicitly select "good" bunch crossing numbers
   Bool_t fUsingCustomClasses; // flag that is set if custom trigger classes are defined
+  Bool_t fShareTriggerDecisions; // flag to evaluate each trigger only once per event for all trigger classes
   TList fCollTrigClasses;     // trigger class identifying collision candidates
   TList fBGTrigClasses;       // trigger classes identifying background events
   TList fTriggerAnalysis;     // list of AliTriggerAnalysis objects (several are needed to keep the control histograms separate per trigger class)
@@ -128,7 +138,12 @@ protected:
   StringToRegexp* fTriggerToRegexp; //!
   TPRegexp& FindRegexp(const std::string& triggers) const;
 
-  ClassDef(AliPhysicsSelection, 24)
+  StringToProgram* fTriggerToProgram; //! Map trigger strings to compiled trigger logic
+  TriggerLogicProgram& FindProgram(const char* triggerLogic);
+
+  TriggerClassMatcher* fTriggerClassMatcher; //! Trigger classes compiled for the current run
+
+  ClassDef(AliPhysicsSelection, 25)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
   AliPhysicsSelection& operator=(const AliPhysicsSelection&);
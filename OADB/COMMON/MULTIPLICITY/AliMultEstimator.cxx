@@ -17,6 +17,7 @@
 #include "AliMultVariable.h"
 #include "TFolder.h"
 #include "TObjString.h"
+#include "TObjArray.h"
 #include "TBrowser.h"
 #include "TFormula.h"
 #include "RVersion.h"
@@ -25,6 +26,7 @@ ClassImp(AliMultEstimator);
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
   TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fVarIndex(), fVars(), fParams(), fVarInput(0), fIsSum(kFALSE),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
   // Constructor
@@ -32,6 +34,7 @@ fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
 TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fVarIndex(), fVars(), fParams(), fVarInput(0), fIsSum(kFALSE),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
     //Named, titled, definition constructor
@@ -46,6 +49,11 @@ fValue(e.fValue),
 fMean(e.fMean),
 fPercentile(e.fPercentile),
 fFormula(0),
+fVarIndex(e.fVarIndex),
+fVars(),
+fParams(e.fParams),
+fVarInput(0),
+fIsSum(e.fIsSum),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
 fAnchorPercentile(e.fAnchorPercentile)
@@ -67,6 +75,11 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     if (fFormula) delete fFormula;
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+    fVarIndex = e.fVarIndex;
+    fParams   = e.fParams;
+    fIsSum    = e.fIsSum;
+    fVars.clear();
+    fVarInput = 0;
     
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
@@ -109,32 +122,90 @@ Float_t AliMultEstimator::GetZ() const {
 //________________________________________________________________
 void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
 {
+    //Compile the definition for this input. Only the variables used by the
+    //definition become formula parameters, and their input indices are kept
+    //in fVarIndex such that Evaluate does not touch the other variables.
+    //A definition which is a plain sum of variables, e.g. (a)+(b), is
+    //evaluated directly, in the same order and precision as TFormula.
+    if (fFormula) delete fFormula;
+    fFormula = 0;
+    fVarIndex.clear();
+    fVars.clear();
+    fVarInput = 0;
+    fIsSum = kFALSE;
+    
+    Int_t nVar = lInput->GetNVariables();
+    
+    //Plain sum of variables?
+    TString lSum = fDefinition;
+    lSum.ReplaceAll(" ", "");
+    TObjArray* lTerms = lSum.Tokenize("+");
+    fIsSum = lTerms->GetEntriesFast() > 0 && !lSum.BeginsWith("+") && !lSum.EndsWith("+") && !lSum.Contains("++");
+    for (Int_t iTerm = 0; fIsSum && iTerm < lTerms->GetEntriesFast(); iTerm++) {
+        TString lTerm = static_cast<TObjString*>(lTerms->At(iTerm))->GetString();
+        Int_t lIdx = -1;
+        if (lTerm.BeginsWith("(") && lTerm.EndsWith(")")) {
+            TString lVarName = lTerm(1, lTerm.Length()-2);
+            for (Int_t i = 0; i < nVar && lIdx < 0; i++)
+                if (lVarName == lInput->GetVariable(i)->GetName()) lIdx = i;
+        }
+        if (lIdx < 0) fIsSum = kFALSE;
+        else          fVarIndex.push_back(lIdx);
+    }
+    delete lTerms;
+    if (fIsSum) return;
+    fVarIndex.clear();
+    
     TString expr = fDefinition;
-    Int_t   nVar = lInput->GetNVariables();
     for (Int_t i = 0; i < nVar; i++) {
-        TString repl(Form("[%d]", i));
         TString lVarName = lInput->GetVariable(i)->GetName();
         //IMPORTANT: this is necessary as names may have a common component!
         //Example: fAmplitude_V0A and fAmplitude_V0AEq
         //Required in syntax: parenthesis around all variables
         lVarName.Append (")");
         lVarName.Prepend("(");
+        if (!expr.Contains(lVarName)) continue;
+        TString repl(Form("[%d]", Int_t(fVarIndex.size())));
         expr.ReplaceAll(lVarName, repl);
+        fVarIndex.push_back(i);
     }
+    fParams.assign(fVarIndex.size() > 0 ? fVarIndex.size() : 1, 0.);
     fFormula = new TFormula(Form("e%s", GetName()), expr);
 #if ROOT_VERSION_CODE < ROOT_VERSION(5,99,4)
     fFormula->Optimize();
 #endif
 }
 //________________________________________________________________
+void AliMultEstimator::ResolveVariables(const AliMultInput* lInput)
+{
+    //Cache the variables of the compiled definition for this input
+    fVars.resize(fVarIndex.size());
+    for (UInt_t k = 0; k < fVarIndex.size(); k++)
+        fVars[k] = lInput->GetVariable(fVarIndex[k]);
+    fVarInput = lInput;
+}
+//________________________________________________________________
 Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
 {
-    if (!fFormula) return fValue = 0;
-    for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
-        AliMultVariable* v = lInput->GetVariable(i);
-        fFormula->SetParameter(i, v->IsInteger() ?
-                               v->GetValueInteger() :
-                               v->GetValue());
+    if (!fFormula && !fIsSum) return fValue = 0;
+    if (lInput != fVarInput || fVars.size() != fVarIndex.size()) ResolveVariables(lInput);
+    const Int_t n = fVars.size();
+    if (fIsSum) {
+        Double_t lSum = 0;
+        for (Int_t k = 0; k < n; k++) {
+            AliMultVariable* v = fVars[k];
+            Double_t x = 0;
+            if (v) x = v->IsInteger() ? v->GetValueInteger() : v->GetValue();
+            lSum = k ? lSum + x : x;
+        }
+        return fValue = lSum;
+    }
+    for (Int_t k = 0; k < n; k++) {
+        AliMultVariable* v = fVars[k];
+        fParams[k] = v ? (v->IsInteger() ?
+                          v->GetValueInteger() :
+                          v->GetValue()) : 0;
     }
-    return fValue = fFormula->Eval(0);
+    Double_t x[4] = {0, 0, 0, 0};
+    return fValue = fFormula->EvalPar(x, &fParams[0]);
 }
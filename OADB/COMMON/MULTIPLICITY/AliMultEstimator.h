@@ -1,7 +1,9 @@
 #ifndef AliMultEstimator_H
 #define AliMultEstimator_H
 #include <TNamed.h>
+#include <vector>
 class AliMultInput;
+class AliMultVariable;
 class TFormula;
 
 class AliMultEstimator : public TNamed {
@@ -43,8 +45,11 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    Bool_t  IsSumOfVariables() const { return fIsSum; }
     
 private:
+    void ResolveVariables(const AliMultInput* lInput);
+    
     TString fDefinition; //How to evaluate based on AliMultVariables
     Bool_t fIsInteger; //Requires special treatment when calibrating
     
@@ -53,6 +58,13 @@ private:
     Float_t fPercentile;   //Percentile
     TFormula* fFormula; //!
     
+    //Compiled form, built in SetupFormula
+    std::vector<Int_t>            fVarIndex;  //! input index of the i-th formula parameter
+    std::vector<AliMultVariable*> fVars;      //! variables resolved from fVarInput
+    std::vector<Double_t>         fParams;    //! parameter buffer for TFormula::EvalPar
+    const AliMultInput*           fVarInput;  //! input for which fVars were resolved
+    Bool_t                        fIsSum;     //! definition is a plain sum of variables
+    
     //Anchor point definition
     Bool_t  fkUseAnchor;        //Use Anchor Logic (default: No)
     Float_t fAnchorPoint;       //Raw value below which
@@ -202,6 +202,15 @@ AliMultEstimator* AliMultSelection::GetEstimator (Long_t lEstIdx) const
     return static_cast<AliMultEstimator*>(fEstimatorList->At(lEstIdx));
 }
 //________________________________________________________________
+Int_t AliMultSelection::GetEstimatorIndex (const TString& lName) const
+{
+    //Position of the estimator in the list, -1 if not found
+    if (!fEstimatorList) return -1;
+    TObject* lEst = fEstimatorList->FindObject(lName);
+    if (!lEst) return -1;
+    return fEstimatorList->IndexOf(lEst);
+}
+//________________________________________________________________
 void AliMultSelection::PrintInfo()
 {
     cout<<"AliMultSelection Name..: "<<GetName()<<endl;
@@ -224,6 +233,19 @@ Float_t AliMultSelection::GetMultiplicityPercentile(TString lName, Bool_t lEmbed
     }
     return lReturnValue;
 }
+//________________________________________________________________
+Float_t AliMultSelection::GetMultiplicityPercentile(Int_t lEstIdx, Bool_t lEmbedEvSel)
+{
+    //Index-based version of the above, for use in the event loop
+    Float_t lReturnValue = AliMultSelectionCuts::kNoCalib;
+    AliMultEstimator *lThis = GetEstimator(lEstIdx);
+    if( lThis ){
+        lReturnValue = lThis->GetPercentile();
+        //Bypass event selection if requested to do so
+        if ( fEvSelCode > 0 && lEmbedEvSel ) lReturnValue = fEvSelCode;
+    }
+    return lReturnValue;
+}
 
 //________________________________________________________________
 Bool_t AliMultSelection::IsEventSelected()
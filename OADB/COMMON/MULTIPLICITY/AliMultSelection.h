@@ -26,10 +26,15 @@ public:
     void     AddEstimator ( AliMultEstimator *lEst );
     AliMultEstimator* GetEstimator (const TString& lName) const;
     AliMultEstimator* GetEstimator (Long_t lEstIdx) const;
+    Int_t  GetEstimatorIndex (const TString& lName) const;
     Long_t GetNEstimators () { return fNEsts; }
     
     //User Functions to get percentiles
     Float_t GetMultiplicityPercentile(TString lName, Bool_t lEmbedEvSel = kFALSE);
+    //Same, with an index from GetEstimatorIndex: resolve it once per run
+    //(the order of the estimators depends on the calibration), then use it
+    //for every event instead of the name look-up
+    Float_t GetMultiplicityPercentile(Int_t lEstIdx, Bool_t lEmbedEvSel = kFALSE);
     Float_t GetZ(TString lName) { return GetEstimator(lName.Data())->GetZ(); }
     
     //Setter and Getter for Event Selection code
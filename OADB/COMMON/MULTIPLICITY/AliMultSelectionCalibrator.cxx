@@ -26,14 +26,26 @@
 #include "TList.h"
 #include "TFile.h"
 #include "TStopwatch.h"
+#include "TMath.h"
+#include <vector>
+#include <algorithm>
+#include <thread>
 
 ClassImp(AliMultSelectionCalibrator);
 
+namespace {
+    //Same ordering as in the sequential calibration, usable as a thread function
+    void SortEstimatorValues(Long64_t n, const Double_t *lValues, Long64_t *lIndex)
+    {
+        TMath::Sort(n, lValues, lIndex);
+    }
+}
+
 AliMultSelectionCalibrator::AliMultSelectionCalibrator() :
     TNamed(), fInputFileName(""), fBufferFileName("buffer.root"),
     fOutputFileName(""), fInput(0), fSelection(0), fMultSelectionCuts(0), fCalibHists(0),
     lNDesiredBoundaries(0), lDesiredBoundaries(0), fRunToUseAsDefault(-1),
-    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0)
+    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0), fNThreads(1)
 {
     // Constructor
 
@@ -60,7 +72,7 @@ AliMultSelectionCalibrator::AliMultSelectionCalibrator(const char * name, const
     TNamed(name,title), fInputFileName(""), fBufferFileName("buffer.root"),
     fOutputFileName(""), fInput(0), fSelection(0), fMultSelectionCuts(0), fCalibHists(0),
     lNDesiredBoundaries(0), lDesiredBoundaries(0), fRunToUseAsDefault(-1),
-    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0)
+    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0), fNThreads(1)
 {
     // Named Constructor
 
@@ -478,6 +490,15 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     //Actual Calibration Histograms
     TH1F * hCalibData[lNEstimators];
 
+    //Multi-threaded sorting of the estimator values (see SetNumberOfThreads)
+    Int_t lNThreads = 1;
+    if ( fNThreads > 1 ) lNThreads = fNThreads;
+    Int_t lBatchFirst = 0;
+    std::vector<Long64_t> lBatchStats(lNThreads, 0);
+    std::vector<std::vector<Double_t> > lBatchValues(lNThreads);
+    std::vector<std::vector<Long64_t> > lBatchIndex(lNThreads);
+    if ( lNThreads > 1 ) cout<<"--- Sorting estimator values with "<<lNThreads<<" threads"<<endl;
+
     cout<<"(5) Generate Boundaries through a loop in all desired estimators"<<endl;
     for(Int_t iRun=0; iRun<fNRunRanges; iRun++) {
 
@@ -500,12 +521,44 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
         index = new Long64_t[ntot];
         //Cast Run Number into drawing conditions
         for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
+            //Multi-threaded sorting: at the start of each batch of estimators,
+            //get the values of the batch (sequentially, TTree::Draw is not
+            //thread-safe) and sort them concurrently, one thread per estimator
+            if ( lNThreads > 1 && ntot > 0 && iEst % lNThreads == 0 ) {
+                lBatchFirst = iEst;
+                for(Int_t k=0; k<lNThreads; k++) {
+                    lBatchValues[k].clear();
+                    lBatchIndex[k].clear();
+                    if ( iEst+k >= lNEstimatorsThis || fSelection->GetEstimator(iEst+k)->IsInteger() ) continue;
+                    lBatchStats[k] = sTree[iRun]->Draw(fSelection->GetEstimator(iEst+k)->GetDefinition(),"","goff");
+                    if ( lBatchStats[k] < 0 || !sTree[iRun]->GetV1() ) continue; //sequential fallback
+                    lBatchValues[k].assign(sTree[iRun]->GetV1(), sTree[iRun]->GetV1()+ntot);
+                    lBatchIndex[k].resize(ntot);
+                }
+                std::vector<std::thread> lWorkers;
+                for(Int_t k=1; k<lNThreads; k++) {
+                    if ( lBatchIndex[k].empty() ) continue;
+                    lWorkers.push_back(std::thread(SortEstimatorValues, ntot, &lBatchValues[k][0], &lBatchIndex[k][0]));
+                }
+                if ( !lBatchIndex[0].empty() ) SortEstimatorValues(ntot, &lBatchValues[0][0], &lBatchIndex[0][0]);
+                for(UInt_t iw=0; iw<lWorkers.size(); iw++) lWorkers[iw].join();
+            }
             if( ! ( fSelection->GetEstimator(iEst)->IsInteger() ) ) {
                 //==== Floating Point Calibration Engine ====
-                lRunStats[iRun] = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),"","goff");
-                cout<<"--- Sorting estimator "<<fSelection->GetEstimator(iEst)->GetName()<<"..."<<flush;
-                
-                TMath::Sort(ntot,sTree[iRun]->GetV1(),index);
+                Bool_t lPresorted = kFALSE;
+                if ( lNThreads > 1 && ntot > 0 && !lBatchIndex[iEst-lBatchFirst].empty() ) {
+                    lPresorted = kTRUE;
+                    lRunStats[iRun] = lBatchStats[iEst-lBatchFirst];
+                    cout<<"--- Sorted estimator "<<fSelection->GetEstimator(iEst)->GetName()<<" (multi-threaded)..."<<flush;
+                    std::copy(lBatchIndex[iEst-lBatchFirst].begin(), lBatchIndex[iEst-lBatchFirst].end(), index);
+                    std::vector<Double_t>().swap(lBatchValues[iEst-lBatchFirst]);
+                }
+                if ( !lPresorted ) {
+                    lRunStats[iRun] = sTree[iRun]->Draw(fSelection->GetEstimator(iEst)->GetDefinition(),"","goff");
+                    cout<<"--- Sorting estimator "<<fSelection->GetEstimator(iEst)->GetName()<<"..."<<flush;
+                    
+                    TMath::Sort(ntot,sTree[iRun]->GetV1(),index);
+                }
                 cout<<" Done! Getting Boundaries... "<<flush;
                 
                 //Special override in case anchored estimator
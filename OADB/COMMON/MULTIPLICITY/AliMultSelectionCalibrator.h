@@ -61,6 +61,12 @@ public:
     //Configure standard input
     void SetupStandardInput();
     
+    //Sort the values of up to n estimators concurrently when determining
+    //the boundaries (n <= 1: sequential, the default). Requires C++11;
+    //memory use grows by n x (events per run) x 16 bytes
+    void SetNumberOfThreads ( Int_t lNThreads ) { fNThreads = lNThreads; }
+    Int_t GetNumberOfThreads () const { return fNThreads; }
+    
     //Master Function in this Class: To be called once filenames are set
     Bool_t Calibrate();
     
@@ -94,11 +100,14 @@ private:
     
     // TList object for storing histograms
     TList *fCalibHists; 
+    
+    Int_t fNThreads; // Number of threads for sorting estimator values
 
-    ClassDef(AliMultSelectionCalibrator, 2);
+    ClassDef(AliMultSelectionCalibrator, 3);
     //(this classdef is only for bookkeeping, class will not usually
     // be streamed according to current workflow except in very specific
     // tests!) 
     //2 - Adjustments of extra event selections
+    //3 - Number of threads for the boundary determination
 };
 #endif
@@ -17,7 +17,7 @@ ClassImp(AliOADBMultSelection);
 //________________________________________________________________
 //Constructors/Destructor
 AliOADBMultSelection::AliOADBMultSelection() :
-TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0), fHistoByIndex()
 {
     // constructor
     // fCalibList = new TList();
@@ -29,7 +29,8 @@ AliOADBMultSelection::AliOADBMultSelection(const AliOADBMultSelection& o)
 fCalibList(0),
 fEventCuts(0),
 fSelection(0),
-fMap(0)
+fMap(0),
+fHistoByIndex()
 {
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
@@ -41,7 +42,7 @@ fMap(0)
 }
 //________________________________________________________________
 AliOADBMultSelection::AliOADBMultSelection(const char * name, const char * title) :
-TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0), fHistoByIndex()
 {
     // constructor
     fCalibList = new TList();
@@ -61,6 +62,7 @@ AliOADBMultSelection& AliOADBMultSelection::operator=(const AliOADBMultSelection
         delete fMap;
         fMap = 0;
     }
+    fHistoByIndex.clear();
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
     TIter next(o.fCalibList);
@@ -225,14 +227,22 @@ TH1F* AliOADBMultSelection::FindHisto(AliMultEstimator* e)
     return static_cast<TH1F*>(ret->Value());
 }
 //________________________________________________________________
+TH1F* AliOADBMultSelection::FindHisto(Long_t iEst) const
+{
+    if (iEst < 0 || iEst >= Long_t(fHistoByIndex.size())) return 0;
+    return fHistoByIndex[iEst];
+}
+//________________________________________________________________
 void AliOADBMultSelection::Setup()
 {
     if (fMap) {
         delete fMap;
         fMap = 0;
     }
+    fHistoByIndex.clear();
     AliMultSelection* sel = GetMultSelection();
     if (!sel) return;
+    fHistoByIndex.assign(sel->GetNEstimators(), (TH1F*)0);
     
     fMap = new TMap;
     fMap->SetOwner(false);
@@ -246,6 +256,7 @@ void AliOADBMultSelection::Setup()
         if (!h) continue;
         
         fMap->Add(e, h);
+        fHistoByIndex[iEst] = h;
     }
 }
 
@@ -2,6 +2,7 @@
 #define ALIOADBMULTSELECTION_H
 
 #include <TNamed.h>
+#include <vector>
 #include <AliMultSelection.h>
 class TBrowser;
 class TH1F;
@@ -39,6 +40,7 @@ public:
     //Use internal map
     void Setup();
     TH1F* FindHisto(AliMultEstimator* e);
+    TH1F* FindHisto(Long_t iEst) const; //by estimator index, after Setup
     void Print(Option_t* option="") const;
     
 private:
@@ -46,6 +48,7 @@ private:
     AliMultSelectionCuts * fEventCuts; // EventCuts
     AliMultSelection     * fSelection; // Definition of Estimators
     TMap*                  fMap; //! Map estimator to histogram
+    std::vector<TH1F*>     fHistoByIndex; //! Histogram of each estimator, by index
     ClassDef(AliOADBMultSelection, 1)
     
     
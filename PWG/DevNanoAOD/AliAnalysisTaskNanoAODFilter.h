@@ -59,6 +59,7 @@ public:
 
   void SetInputArrayName(TString name) {fInputArrayName=name;}
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
+  void SetColumnarOutput(Bool_t var = kTRUE) {fColumnarOutput=var;}
 
 private:
   Int_t fMCMode; // true if processing monte carlo. if > 1 not all MC particles are filtered
@@ -77,11 +78,12 @@ private:
 
   TString fInputArrayName; // name of TObjectArray of Tracks
   TString fOutputArrayName; // name of TObjectArray of AliNanoAODTracks
+  Bool_t fColumnarOutput; // if kTRUE the tracks are written as one branch per variable (see AliNanoAODColumn)
 
   AliAnalysisTaskNanoAODFilter(const AliAnalysisTaskNanoAODFilter&); // not implemented
   AliAnalysisTaskNanoAODFilter& operator=(const AliAnalysisTaskNanoAODFilter&); // not implemented
 
-  ClassDef(AliAnalysisTaskNanoAODFilter, 4); // example of analysis
+  ClassDef(AliAnalysisTaskNanoAODFilter, 5); // example of analysis
 };
 
 #endif
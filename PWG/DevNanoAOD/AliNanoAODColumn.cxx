@@ -0,0 +1,227 @@
+#include "AliNanoAODColumn.h"
+
+#include "TMath.h"
+#include "TTree.h"
+#include "AliAODEvent.h"
+#include "AliLog.h"
+
+ClassImp(AliNanoAODColumn)
+ClassImp(AliNanoAODIntColumn)
+ClassImp(AliNanoAODColumnReader)
+
+//_____________________________________________________________________________
+AliNanoAODColumn::AliNanoAODColumn(const char * name) :
+  TNamed(name, name),
+  fN(0),
+  fSize(0),
+  fValues(0)
+{
+  // ctor
+}
+
+//_____________________________________________________________________________
+AliNanoAODColumn::AliNanoAODColumn(const AliNanoAODColumn & col) :
+  TNamed(col),
+  fN(0),
+  fSize(0),
+  fValues(0)
+{
+  // copy ctor
+  Reserve(col.fN);
+  for (Int_t i = 0; i < col.fN; i++) fValues[i] = col.fValues[i];
+  fN = col.fN;
+}
+
+//_____________________________________________________________________________
+AliNanoAODColumn & AliNanoAODColumn::operator=(const AliNanoAODColumn & col)
+{
+  // assignment
+  if (&col == this) return *this;
+  TNamed::operator=(col);
+  fN = 0;
+  Reserve(col.fN);
+  for (Int_t i = 0; i < col.fN; i++) fValues[i] = col.fValues[i];
+  fN = col.fN;
+  return *this;
+}
+
+//_____________________________________________________________________________
+AliNanoAODColumn::~AliNanoAODColumn()
+{
+  // dtor
+  delete [] fValues;
+}
+
+//_____________________________________________________________________________
+void AliNanoAODColumn::Reserve(Int_t size)
+{
+  // Make room for at least size values, keeping the current ones.
+  // fSize is transient: after reading, the array has exactly fN entries.
+  if (fSize < fN) fSize = fN;
+  if (size <= fSize) return;
+  Float_t * values = new Float_t[size];
+  for (Int_t i = 0; i < fN; i++) values[i] = fValues[i];
+  delete [] fValues;
+  fValues = values;
+  fSize = size;
+}
+
+//_____________________________________________________________________________
+AliNanoAODIntColumn::AliNanoAODIntColumn(const char * name) :
+  TNamed(name, name),
+  fN(0),
+  fSize(0),
+  fValues(0)
+{
+  // ctor
+}
+
+//_____________________________________________________________________________
+AliNanoAODIntColumn::AliNanoAODIntColumn(const AliNanoAODIntColumn & col) :
+  TNamed(col),
+  fN(0),
+  fSize(0),
+  fValues(0)
+{
+  // copy ctor
+  Reserve(col.fN);
+  for (Int_t i = 0; i < col.fN; i++) fValues[i] = col.fValues[i];
+  fN = col.fN;
+}
+
+//_____________________________________________________________________________
+AliNanoAODIntColumn & AliNanoAODIntColumn::operator=(const AliNanoAODIntColumn & col)
+{
+  // assignment
+  if (&col == this) return *this;
+  TNamed::operator=(col);
+  fN = 0;
+  Reserve(col.fN);
+  for (Int_t i = 0; i < col.fN; i++) fValues[i] = col.fValues[i];
+  fN = col.fN;
+  return *this;
+}
+
+//_____________________________________________________________________________
+AliNanoAODIntColumn::~AliNanoAODIntColumn()
+{
+  // dtor
+  delete [] fValues;
+}
+
+//_____________________________________________________________________________
+void AliNanoAODIntColumn::Reserve(Int_t size)
+{
+  // Make room for at least size values, keeping the current ones
+  if (fSize < fN) fSize = fN;
+  if (size <= fSize) return;
+  Int_t * values = new Int_t[size];
+  for (Int_t i = 0; i < fN; i++) values[i] = fValues[i];
+  delete [] fValues;
+  fValues = values;
+  fSize = size;
+}
+
+//_____________________________________________________________________________
+AliNanoAODColumnReader::AliNanoAODColumnReader(const char * arrayName) :
+  TObject(),
+  fArrayName(arrayName),
+  fVarNames(),
+  fColumns(),
+  fCharge(0),
+  fLabel(0),
+  fPt(-1),
+  fPhi(-1),
+  fTheta(-1),
+  fEta()
+{
+  // ctor. Usage, in a task reading a columnar nano AOD:
+  //
+  //   UserCreateOutputObjects: fReader = new AliNanoAODColumnReader("tracks");
+  //                            fReader->AddColumn("pt"); fReader->AddColumn("theta");
+  //                            iTOF = fReader->AddColumn("cstNSigmaTOFPi");
+  //   UserNotify:              fReader->Connect(aodEvent, fInputHandler->GetTree());
+  //   UserExec:                Int_t n = fReader->GetNumberOfTracks();
+  //                            const Float_t * pt = fReader->GetPt();
+  //                            const Float_t * nsigma = fReader->Get(iTOF);
+  //                            for (Int_t i = 0; i < n; i++) { ... pt[i] ... }
+}
+
+//_____________________________________________________________________________
+Int_t AliNanoAODColumnReader::AddColumn(const char * var)
+{
+  // Request a variable, returns the column index to be used with Get()
+  for (UInt_t i = 0; i < fVarNames.size(); i++) {
+    if (fVarNames[i] == var) return i;
+  }
+  Int_t index = fVarNames.size();
+  fVarNames.push_back(var);
+  fColumns.push_back(0);
+  if      (fVarNames[index] == "pt")    fPt    = index;
+  else if (fVarNames[index] == "phi")   fPhi   = index;
+  else if (fVarNames[index] == "theta") fTheta = index;
+  return index;
+}
+
+//_____________________________________________________________________________
+Bool_t AliNanoAODColumnReader::Connect(const AliAODEvent * event, TTree * tree)
+{
+  // Find the requested columns, charge and label in the event. To be called
+  // whenever the input tree changes (e.g. in UserNotify). If the tree is
+  // given, the branches of the columns which were not requested are
+  // disabled, such that they are not read.
+  if (!event) return kFALSE;
+
+  if (tree) {
+    tree->SetBranchStatus(Form("%s_*", fArrayName.Data()), 0);
+    tree->SetBranchStatus(Form("%s_charge", fArrayName.Data()), 1);
+    tree->SetBranchStatus(Form("%s_label", fArrayName.Data()), 1);
+    for (UInt_t i = 0; i < fVarNames.size(); i++)
+      tree->SetBranchStatus(Form("%s_%s", fArrayName.Data(), fVarNames[i].Data()), 1);
+  }
+
+  Bool_t ok = kTRUE;
+  for (UInt_t i = 0; i < fVarNames.size(); i++) {
+    fColumns[i] = dynamic_cast<AliNanoAODColumn*>(event->FindListObject(Form("%s_%s", fArrayName.Data(), fVarNames[i].Data())));
+    if (!fColumns[i]) {
+      AliError(Form("Column %s_%s not found", fArrayName.Data(), fVarNames[i].Data()));
+      ok = kFALSE;
+    }
+  }
+  fCharge = dynamic_cast<AliNanoAODIntColumn*>(event->FindListObject(Form("%s_charge", fArrayName.Data())));
+  fLabel  = dynamic_cast<AliNanoAODIntColumn*>(event->FindListObject(Form("%s_label", fArrayName.Data())));
+  if (!fCharge) ok = kFALSE;
+  return ok;
+}
+
+//_____________________________________________________________________________
+Int_t AliNanoAODColumnReader::GetNumberOfTracks() const
+{
+  // Number of tracks in the current event
+  if (fCharge) return fCharge->GetN();
+  for (UInt_t i = 0; i < fColumns.size(); i++) {
+    if (fColumns[i]) return fColumns[i]->GetN();
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+const Float_t * AliNanoAODColumnReader::Get(Int_t column) const
+{
+  // Values of a requested column in the current event, 0 if not available
+  if (column < 0 || column >= Int_t(fColumns.size()) || !fColumns[column]) return 0;
+  return fColumns[column]->GetArray();
+}
+
+//_____________________________________________________________________________
+const Double_t * AliNanoAODColumnReader::GetEta()
+{
+  // Pseudorapidity of the tracks of the current event, computed from theta
+  // as in AliNanoAODTrack::Eta(). Requires the theta column.
+  const Float_t * theta = GetTheta();
+  if (!theta) return 0;
+  Int_t n = fColumns[fTheta]->GetN();
+  fEta.resize(n > 0 ? n : 1);
+  for (Int_t i = 0; i < n; i++) fEta[i] = -TMath::Log(TMath::Tan(0.5 * theta[i]));
+  return &fEta[0];
+}
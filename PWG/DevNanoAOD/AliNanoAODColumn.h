@@ -0,0 +1,108 @@
+#ifndef _ALINANOAODCOLUMN_H_
+#define _ALINANOAODCOLUMN_H_
+
+// AliNanoAODColumn, AliNanoAODIntColumn
+
+// Columnar storage of one track variable of a nano AOD. In columnar
+// mode (AliNanoAODReplicator::SetColumnarOutput) every selected track
+// variable is written as its own object, hence its own split branch
+// named <array name>_<variable>, holding the values of all tracks of
+// the event contiguously. Charge and label are stored as integer
+// columns. The values are identical to the ones of the AliNanoAODTrack
+// array (the Double32_t track variables are written as floats as well).
+//
+// AliNanoAODColumnReader gives per-event access to the columns a task
+// needs and disables the branches of the other ones.
+
+
+#include "TNamed.h"
+
+#include <vector>
+
+class AliAODEvent;
+class TTree;
+
+class AliNanoAODColumn : public TNamed
+{
+public:
+  AliNanoAODColumn(const char * name = "AliNanoAODColumn");
+  AliNanoAODColumn(const AliNanoAODColumn & col);
+  AliNanoAODColumn & operator=(const AliNanoAODColumn & col);
+  virtual ~AliNanoAODColumn();
+
+  virtual void Clear(Option_t * /*opt*/ = "") { fN = 0; }
+  void Push(Float_t val) { if (fN >= fSize) Reserve(2*fN + 16); fValues[fN++] = val; }
+  void Reserve(Int_t size);
+
+  Int_t GetN() const { return fN; }
+  const Float_t * GetArray() const { return fValues; }
+  Float_t At(Int_t i) const { return fValues[i]; }
+
+private:
+  Int_t     fN;      // number of tracks in the event
+  Int_t     fSize;   //! allocated size of fValues
+  Float_t * fValues; //[fN] value of each track
+
+  ClassDef(AliNanoAODColumn, 1)
+};
+
+class AliNanoAODIntColumn : public TNamed
+{
+public:
+  AliNanoAODIntColumn(const char * name = "AliNanoAODIntColumn");
+  AliNanoAODIntColumn(const AliNanoAODIntColumn & col);
+  AliNanoAODIntColumn & operator=(const AliNanoAODIntColumn & col);
+  virtual ~AliNanoAODIntColumn();
+
+  virtual void Clear(Option_t * /*opt*/ = "") { fN = 0; }
+  void Push(Int_t val) { if (fN >= fSize) Reserve(2*fN + 16); fValues[fN++] = val; }
+  void Reserve(Int_t size);
+
+  Int_t GetN() const { return fN; }
+  const Int_t * GetArray() const { return fValues; }
+  Int_t At(Int_t i) const { return fValues[i]; }
+
+private:
+  Int_t   fN;      // number of tracks in the event
+  Int_t   fSize;   //! allocated size of fValues
+  Int_t * fValues; //[fN] value of each track
+
+  ClassDef(AliNanoAODIntColumn, 1)
+};
+
+class AliNanoAODColumnReader : public TObject
+{
+public:
+  AliNanoAODColumnReader(const char * arrayName = "tracks");
+  virtual ~AliNanoAODColumnReader() {;}
+
+  Int_t  AddColumn(const char * var);
+  Bool_t Connect(const AliAODEvent * event, TTree * tree = 0);
+
+  Int_t           GetNumberOfTracks() const;
+  const Float_t * Get(Int_t column) const;
+  const Float_t * GetPt()     const { return Get(fPt);    }
+  const Float_t * GetPhi()    const { return Get(fPhi);   }
+  const Float_t * GetTheta()  const { return Get(fTheta); }
+  const Double_t* GetEta();
+  const Int_t   * GetCharge() const { return fCharge ? fCharge->GetArray() : 0; }
+  const Int_t   * GetLabel()  const { return fLabel  ? fLabel->GetArray()  : 0; }
+
+private:
+  AliNanoAODColumnReader(const AliNanoAODColumnReader &);             // not implemented
+  AliNanoAODColumnReader & operator=(const AliNanoAODColumnReader &); // not implemented
+
+  TString                          fArrayName; // name of the track array the columns belong to
+  std::vector<TString>             fVarNames;  // requested variables
+  std::vector<AliNanoAODColumn *>  fColumns;   //! columns of the requested variables
+  AliNanoAODIntColumn *            fCharge;    //! charge column
+  AliNanoAODIntColumn *            fLabel;     //! label column
+  Int_t                            fPt;        // column index of pt
+  Int_t                            fPhi;       // column index of phi
+  Int_t                            fTheta;     // column index of theta
+  std::vector<Double_t>            fEta;       //! eta computed from theta
+
+  ClassDef(AliNanoAODColumnReader, 1)
+};
+
+#endif /* _ALINANOAODCOLUMN_H_ */
@@ -75,6 +75,7 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODColumn.h"
 
 using std::cout;
 using std::endl;
@@ -103,6 +104,10 @@ AliAODBranchReplicator(),
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fColumnar(kFALSE),
+  fColumns(0x0),
+  fChargeColumn(0x0),
+  fLabelColumn(0x0),
   fVarListHeader_fTC(""){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file
   }
@@ -134,6 +139,10 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
+  fColumnar(kFALSE),
+  fColumns(0x0),
+  fChargeColumn(0x0),
+  fLabelColumn(0x0),
   fVarListHeader_fTC("")
 {
   // default ctor
@@ -158,6 +167,8 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
   // dtor
   delete fTrackCut;
   delete fList;
+  if (fColumns) delete fTracks; // not owned by fList in columnar mode
+  delete fColumns; // the columns themselves are owned by fList
 }
 
 //_____________________________________________________________________________
@@ -437,7 +448,24 @@ TList* AliNanoAODReplicator::GetList() const
 
       fTracks = new TClonesArray("AliNanoAODTrack");
       fTracks->SetName(fOutputArrayName.Data()); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);
+      if (!fColumnar) {
+        fList->Add(fTracks);
+      }
+      else {
+        // The tracks are still built internally (custom setter, MC label
+        // remapping), but only their columns are written
+        Int_t nvars = AliNanoAODTrackMapping::GetInstance()->GetSize();
+        fColumns = new TObjArray(nvars);
+        for (Int_t ivar = 0; ivar < nvars; ivar++) {
+          AliNanoAODColumn * col = new AliNanoAODColumn(Form("%s_%s", fOutputArrayName.Data(), AliNanoAODTrackMapping::GetInstance()->GetVarName(ivar)));
+          fColumns->AddAt(col, ivar);
+          fList->Add(col);
+        }
+        fChargeColumn = new AliNanoAODIntColumn(Form("%s_charge", fOutputArrayName.Data()));
+        fLabelColumn  = new AliNanoAODIntColumn(Form("%s_label", fOutputArrayName.Data()));
+        fList->Add(fChargeColumn);
+        fList->Add(fLabelColumn);
+      }
 
       fHeader = new AliNanoAODHeader(fNumberOfHeaderParam, fNumberOfHeaderParamInt);
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -485,6 +513,11 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
 
   fTracks->Clear("C");			
+  if (fColumns) {
+    for (Int_t ivar = 0; ivar < fColumns->GetEntriesFast(); ivar++) fColumns->UncheckedAt(ivar)->Clear();
+    fChargeColumn->Clear();
+    fLabelColumn->Clear();
+  }
   assert(fVertices!=0x0);
   fVertices->Clear("C");
   if (fMCMode > 0){
@@ -575,7 +608,32 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     FilterMC(source);      
   }
   
+  if (fColumns) FillColumns();
+
+}
 
+//_____________________________________________________________________________
+void AliNanoAODReplicator::FillColumns()
+{
+  // Copy the selected tracks into the columns. Done after the MC filtering,
+  // such that the labels are the remapped ones.
+
+  Int_t ntracks = fTracks->GetEntriesFast();
+  Int_t nvars = fColumns->GetEntriesFast();
+  for (Int_t ivar = 0; ivar < nvars; ivar++) {
+    AliNanoAODColumn * col = static_cast<AliNanoAODColumn*>(fColumns->UncheckedAt(ivar));
+    col->Reserve(ntracks);
+    for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+      col->Push(static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack))->GetVar(ivar));
+    }
+  }
+  fChargeColumn->Reserve(ntracks);
+  fLabelColumn->Reserve(ntracks);
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    AliNanoAODTrack * track = static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack));
+    fChargeColumn->Push(track->Charge());
+    fLabelColumn->Push(track->GetLabel());
+  }
 }
 
 
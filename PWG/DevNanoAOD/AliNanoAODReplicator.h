@@ -30,6 +30,7 @@
 
 class AliAnalysisCuts;
 class TClonesArray;
+class TObjArray;
 class AliAODMCHeader;
 class AliAODVZERO;
 class AliAODTZERO;
@@ -57,6 +58,7 @@ class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 class AliAODZDC;
+class AliNanoAODIntColumn;
 
 class TH1F;
 
@@ -102,6 +104,10 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
 
   void SetVarListHeaderStringVariable(TString var) {fVarListHeader_fTC=var;}
+
+  // Columnar output: one branch per track variable instead of the array of AliNanoAODTracks (see AliNanoAODColumn)
+  void SetColumnarOutput(Bool_t b = kTRUE) { fColumnar = b; }
+  Bool_t GetColumnarOutput() const { return fColumnar; }
     
  private:
 
@@ -110,6 +116,7 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void CreateLabelMap(const AliAODEvent& source);
   Int_t GetNewLabel(Int_t i);
   void FilterMC(const AliAODEvent& source);
+  void FillColumns();
  
 
  private:
@@ -146,13 +153,18 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   TString fInputArrayName; // name of array if tracks are stored in a TObjectArray
   TString fOutputArrayName; // name of the output array, where the NanoAODTracks are stored
+
+  Bool_t fColumnar; // if kTRUE the tracks are written as columns, one branch per variable
+  mutable TObjArray* fColumns; //! columns of the track variables, in the order of the track mapping
+  mutable AliNanoAODIntColumn* fChargeColumn; //! column of the track charges
+  mutable AliNanoAODIntColumn* fLabelColumn; //! column of the track labels
  private:
 
 
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
 
-  ClassDef(AliNanoAODReplicator,4) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,5) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -14,5 +14,8 @@
 #pragma link C++ class AliAnalysisNanoAODEventCutsCRCZDC+;
 #pragma link C++ class AliNanoAODSimpleSetterCRCZDC+;
 #pragma link C++ class AliNanoAODSimpleSetterJet+;
+#pragma link C++ class AliNanoAODColumn+;
+#pragma link C++ class AliNanoAODIntColumn+;
+#pragma link C++ class AliNanoAODColumnReader+;
 
 #endif
@@ -138,7 +138,7 @@ AliVCluster* AliClusterContainer::GetAcceptCluster(Int_t i) const
   if (!vc) return 0;
 
   UInt_t rejectionReason = 0;
-  if (AcceptCluster(vc, rejectionReason))
+  if (AcceptObjectCached(i, rejectionReason))
     return vc;
   else {
     AliDebug(2,"Cluster not accepted.");
@@ -412,6 +412,8 @@ Bool_t AliClusterContainer::ApplyClusterCuts(const AliVCluster* clus, UInt_t &re
  */
 Int_t AliClusterContainer::GetNAcceptedClusters() const
 {
+  if (fCacheAcceptance) return GetNAcceptEntries();
+
   UInt_t rejectionReason = 0;
   Int_t nClus = 0;
   for(int iclust = 0; iclust < this->fClArray->GetEntries(); ++iclust){
@@ -449,6 +451,7 @@ void AliClusterContainer::SetClusUserDefEnergyCut(Int_t t, Double_t cut)
   else {
     fMinE = cut;
   }
+  InvalidateAcceptCache();
 }
 
 /**
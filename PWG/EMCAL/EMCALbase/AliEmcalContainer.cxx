@@ -55,6 +55,12 @@ AliEmcalContainer::AliEmcalContainer():
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fCacheAcceptance(kFALSE),
+  fAcceptCacheValid(kFALSE),
+  fAcceptCacheFlags(),
+  fAcceptCacheReasons(),
+  fAcceptCacheIndices(),
+  fNAcceptCacheIndices(0),
   fClassName()
 {
   fVertex[0] = 0;
@@ -92,6 +98,12 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fCacheAcceptance(kFALSE),
+  fAcceptCacheValid(kFALSE),
+  fAcceptCacheFlags(),
+  fAcceptCacheReasons(),
+  fAcceptCacheIndices(),
+  fNAcceptCacheIndices(0),
   fClassName()
 {
   fVertex[0] = 0;
@@ -165,6 +177,7 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
   }
 
   fLoadedClass = fClArray->GetClass();
+  InvalidateAcceptCache();
 
   if (!fClassName.IsNull()) {
     if (!fLoadedClass->InheritsFrom(fClassName)) {
@@ -184,6 +197,9 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
  */
 void AliEmcalContainer::NextEvent(const AliVEvent * event)
 {
+  // The selection has to be evaluated again for the new event
+  InvalidateAcceptCache();
+
   // Get the right event (either the current event of the embedded event)
   event = AliEmcalContainerUtils::GetEvent(event, fIsEmbedding);
 
@@ -197,6 +213,10 @@ void AliEmcalContainer::NextEvent(const AliVEvent * event)
  * @return Number of accepted events in the container
  */
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  if (fCacheAcceptance) {
+    BuildAcceptCache();
+    return fNAcceptCacheIndices;
+  }
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
@@ -205,6 +225,70 @@ Int_t AliEmcalContainer::GetNAcceptEntries() const{
   return result;
 }
 
+/**
+ * Selection of the object at a given index, evaluated at most once per event if
+ * the accept cache is enabled (otherwise the same as AcceptObject()).
+ * @param[in] i Index of the object
+ * @param[out] rejectionReason Bitmap with the reason why the object was rejected.
+ * Note: as in AcceptObject() the value is not set to 0 in the function.
+ * @return True if the object is accepted, false otherwise
+ */
+Bool_t AliEmcalContainer::AcceptObjectCached(Int_t i, UInt_t &rejectionReason) const
+{
+  if (!fCacheAcceptance) return AcceptObject(i, rejectionReason);
+
+  BuildAcceptCache();
+  if (i < 0 || i >= fAcceptCacheFlags.GetSize()) return AcceptObject(i, rejectionReason);
+
+  rejectionReason |= static_cast<UInt_t>(fAcceptCacheReasons[i]);
+  return fAcceptCacheFlags[i] != 0;
+}
+
+/**
+ * Fill the indices of all accepted objects of the current event, in ascending order.
+ * @param[out] indices Array with the accepted indices, resized to the number of accepted objects
+ */
+void AliEmcalContainer::GetAcceptIndices(TArrayI &indices) const
+{
+  if (fCacheAcceptance) {
+    BuildAcceptCache();
+    indices.Set(fNAcceptCacheIndices, fAcceptCacheIndices.GetArray());
+    return;
+  }
+
+  const Int_t n = GetNEntries();
+  indices.Set(n);
+  Int_t acceptCounter = 0;
+  for (Int_t index = 0; index < n; index++) {
+    UInt_t rejectionReason = 0;
+    if (AcceptObject(index, rejectionReason)) indices[acceptCounter++] = index;
+  }
+  indices.Set(acceptCounter);
+}
+
+/**
+ * Evaluate the selection of all objects in the container, if not done yet for the
+ * current event and cuts. A change in the number of entries also triggers a re-evaluation.
+ */
+void AliEmcalContainer::BuildAcceptCache() const
+{
+  const Int_t n = GetNEntries();
+  if (fAcceptCacheValid && fAcceptCacheFlags.GetSize() == n) return;
+
+  fAcceptCacheFlags.Set(n);
+  fAcceptCacheReasons.Set(n);
+  fAcceptCacheIndices.Set(n);
+  fNAcceptCacheIndices = 0;
+  for (Int_t index = 0; index < n; index++) {
+    UInt_t rejectionReason = 0;
+    Bool_t accepted = AcceptObject(index, rejectionReason);
+    fAcceptCacheFlags[index] = accepted;
+    fAcceptCacheReasons[index] = rejectionReason;
+    if (accepted) fAcceptCacheIndices[fNAcceptCacheIndices++] = index;
+  }
+  fAcceptCacheValid = kTRUE;
+}
+
 /**
  * Get the index in the container from a given label
  * @param lab Label to check
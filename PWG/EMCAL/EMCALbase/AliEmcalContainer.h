@@ -13,6 +13,8 @@ class AliVParticle;
 
 #include <TNamed.h>
 #include <TClonesArray.h>
+#include <TArrayC.h>
+#include <TArrayI.h>
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_object<TObject> > AliEmcalIterableContainer;
@@ -70,6 +72,14 @@ typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterabl
  * }
  * ~~~
  *
+ * With SetCacheAcceptance(kTRUE) the selection of each object is evaluated at most once
+ * per event: the result and the rejection reason are cached on first use after NextEvent()
+ * and reused by the accept iterators and the GetAccept... accessors (see AcceptObjectCached()).
+ * Changing the cuts of the container resets the cache. The cache is off by default. It must
+ * not be enabled if the selection depends on properties of the objects that change during
+ * the event (e.g. rho, tagging or matching information of jets), unless InvalidateAcceptCache()
+ * is called after each such change.
+ *
  * The usage of EMCAL containers is described under \subpage EMCALcontainers
  */
 class AliEmcalContainer : public TObject {
@@ -151,28 +161,33 @@ class AliEmcalContainer : public TObject {
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const = 0;
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const = 0;
   Int_t                       GetNAcceptEntries() const;
+  Bool_t                      AcceptObjectCached(Int_t i, UInt_t &rejectionReason) const;
+  void                        GetAcceptIndices(TArrayI &indices) const;
+  void                        SetCacheAcceptance(Bool_t b)          { fCacheAcceptance = b; InvalidateAcceptCache(); }
+  Bool_t                      GetCacheAcceptance()            const { return fCacheAcceptance           ; }
+  void                        InvalidateAcceptCache()               { fAcceptCacheValid = kFALSE        ; }
   void                        ResetCurrentID(Int_t i=-1)            { fCurrentID = i                    ; }
   virtual void                SetArray(const AliVEvent *event);
   void                        SetArrayName(const char *n)           { fClArrayName = n                  ; }
-  void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); }
-  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; }
+  void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); InvalidateAcceptCache(); }
+  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; InvalidateAcceptCache(); }
   void                        SetIsParticleLevel(Bool_t b)          { fIsParticleLevel = b              ; }
   void                        SortArray()                           { fClArray->Sort()                  ; }
 
   TClass*                     GetLoadedClass()                      { return fLoadedClass               ; }
   virtual void                NextEvent(const AliVEvent *event);
-  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; }
-  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; }
+  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; InvalidateAcceptCache(); }
+  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; InvalidateAcceptCache(); }
   void                        SetMCLabelRange(Int_t min, Int_t max)             { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
-  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; }
-  void                        SetMinE(Double_t min)                     { fMinE   = min ; }
-  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; }
-  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; }
-  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; }
-  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; }
-  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; }
-  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; }
-  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; }
+  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; InvalidateAcceptCache(); }
+  void                        SetMinE(Double_t min)                     { fMinE   = min ; InvalidateAcceptCache(); }
+  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; InvalidateAcceptCache(); }
+  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; InvalidateAcceptCache(); }
+  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; InvalidateAcceptCache(); }
+  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; InvalidateAcceptCache(); }
+  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; InvalidateAcceptCache(); }
+  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; InvalidateAcceptCache(); }
+  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; InvalidateAcceptCache(); }
   void                        SetClassName(const char *clname);
   void                        SetIsEmbedding(Bool_t b)                  { fIsEmbedding = b ; }
   Bool_t                      GetIsEmbedding() const                    { return fIsEmbedding; }
@@ -203,6 +218,7 @@ class AliEmcalContainer : public TObject {
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const { return ""; }
   void                        GetVertexFromEvent(const AliVEvent * event);
+  void                        BuildAcceptCache() const;
 
   TString                     fName;                    ///< object name
   TString                     fClArrayName;             ///< name of branch
@@ -226,6 +242,12 @@ class AliEmcalContainer : public TObject {
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  Bool_t                      fCacheAcceptance;         ///< evaluate the selection once per event and cache the result (default=off)
+  mutable Bool_t              fAcceptCacheValid;        //!<! whether the accept cache corresponds to the current event and cuts
+  mutable TArrayC             fAcceptCacheFlags;        //!<! selection result per object in the current event
+  mutable TArrayI             fAcceptCacheReasons;      //!<! rejection reason per object in the current event
+  mutable TArrayI             fAcceptCacheIndices;      //!<! indices of the accepted objects in the current event
+  mutable Int_t               fNAcceptCacheIndices;     //!<! number of accepted objects in the current event
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -234,7 +256,7 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalContainer,9);
+  ClassDef(AliEmcalContainer,10);
   /// \endcond
 };
 #endif
@@ -47,8 +47,8 @@ class AliMCParticleContainer : public AliParticleContainer {
   virtual AliVParticle       *GetNextAcceptParticle()                         { return GetNextAcceptMCParticle()  ; }
   virtual AliVParticle       *GetNextParticle()                               { return GetNextMCParticle()        ; }
 
-  void                        SetMCFlag(UInt_t m)                             { fMCFlag          = m ; }
-  void                        SelectPhysicalPrimaries(Bool_t s)               { if (s) fMCFlag |=  AliAODMCParticle::kPhysicalPrim ;   }
+  void                        SetMCFlag(UInt_t m)                             { fMCFlag          = m ; InvalidateAcceptCache(); }
+  void                        SelectPhysicalPrimaries(Bool_t s)               { if (s) fMCFlag |=  AliAODMCParticle::kPhysicalPrim ; InvalidateAcceptCache();   }
 
   const char*                 GetTitle() const;
 
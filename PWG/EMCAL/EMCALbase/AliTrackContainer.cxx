@@ -211,7 +211,7 @@ AliVTrack* AliTrackContainer::GetAcceptTrack(Int_t i) const
 {
   UInt_t rejectionReason;
   if (i == -1) i = fCurrentID;
-  if (AcceptTrack(i, rejectionReason)) {
+  if (AcceptObjectCached(i, rejectionReason)) {
       return GetTrack(i);
   }
   else {
@@ -528,6 +528,7 @@ void AliTrackContainer::AddTrackCuts(AliVCuts *cuts)
     fListOfCuts->SetOwner(true);
   }
   fListOfCuts->Add(cuts);
+  InvalidateAcceptCache();
 }
 
 /**
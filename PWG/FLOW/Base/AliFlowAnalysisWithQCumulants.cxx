@@ -43,6 +43,7 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithQCumulants.h"
+#include "AliFlowQVectorEngine.h"
 #include "TArrayD.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -100,6 +101,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fHarmonic(2),
  fAnalysisLabel(NULL),
  fMaxCommonResultsHistogram(8),
+ fQVectorEngine(NULL),
  // 2a.) particle weights:
  fWeightsList(NULL),
  fUsePhiWeights(kFALSE),
@@ -271,6 +273,7 @@ AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
  // destructor
  
  delete fHistList;
+ delete fQVectorEngine;
 
 } // end of AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
 
@@ -376,22 +379,34 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}                                                              
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
- Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
- AliFlowTrackSimple *aftsTrack = NULL;
+ //    cos/sin of all harmonics and all powers of the particle weight are calculated once per track 
+ //    (see AliFlowQVectorEngine) and reused for integrated and differential Q-vectors:
+ if(!fQVectorEngine){fQVectorEngine = new AliFlowQVectorEngine();}
+ AliFlowQVectorEngine *qve = fQVectorEngine; // shortcut
+ Int_t nPrim = qve->LoadEvent(anEvent);  // nPrim = total number of primary tracks
  Int_t n = fHarmonic; // shortcut for the harmonic 
+ const Int_t nHarmonicsQ = 12; // Q_{m*n,k} for m = 1,...,12 // to be improved - hardwired 12
+ const Int_t nHarmonicsDiff = 4; // p_{m*n,k}, q_{m*n,k} and r_{m*n,k} for m = 1,...,4 // to be improved - hardwired 4
+ const Int_t nPowers = 9; // k = 0,...,8 // to be improved - hardwired 9
+ Double_t dCos[nHarmonicsQ] = {0.}; // cos((m+1)*n*dPhi)
+ Double_t dSin[nHarmonicsQ] = {0.}; // sin((m+1)*n*dPhi)
+ Double_t dWeightToPower[nPowers] = {0.}; // (wPhi*wPt*wEta*wTrack)^k
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
-  {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())){continue;} // safety measure: consider only tracks which are RPs or POIs
-   if(aftsTrack->InRPSelection()) // RP condition:
+  if(qve->HasTrack(i))
+  {
+   if(!(qve->IsRP(i) || qve->IsPOI(i))){continue;} // safety measure: consider only tracks which are RPs or POIs
+   dPhi = qve->GetPhi(i);
+   dPt  = qve->GetPt(i);
+   dEta = qve->GetEta(i);
+   ptEta[0] = dPt; 
+   ptEta[1] = dEta; 
+   // cos((m+1)*n*dPhi) and sin((m+1)*n*dPhi), the same for RPs and POIs:
+   AliFlowQVectorEngine::CosSinMultiples(n*dPhi,nHarmonicsQ,dCos,dSin);
+   if(qve->IsRP(i)) // RP condition:
    {    
     nCounterNoRPs++;
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
     if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -407,142 +422,113 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     // Access track weight:
     if(fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
+     wTrack = qve->GetWeight(i); 
     }
+    AliFlowQVectorEngine::WeightPowers(wPhi*wPt*wEta*wTrack,nPowers,dWeightToPower);
     // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+    for(Int_t m=0;m<nHarmonicsQ;m++)
     {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     for(Int_t k=0;k<nPowers;k++)
      {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
+      (*fReQ)(m,k)+=dWeightToPower[k]*dCos[m]; 
+      (*fImQ)(m,k)+=dWeightToPower[k]*dSin[m]; 
      } 
     }
     // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
     for(Int_t p=0;p<8;p++)
     {
-     for(Int_t k=0;k<9;k++)
+     for(Int_t k=0;k<nPowers;k++)
      {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
+      (*fSpk)(p,k)+=dWeightToPower[k];
      }
     } 
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
-     ptEta[0] = dPt; 
-     ptEta[1] = dEta; 
-     // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs), 
+     // and if RP particle is also POI particle q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
+     for(Int_t rq=0;rq<=2;rq+=2) // 0 = RP, 2 = RP && POI
      {
-      for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+      if(rq==2 && !qve->IsPOI(i)){break;}
+      for(Int_t k=0;k<nPowers;k++)
       {
-       if(fCalculateDiffFlow)
-       {
-        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-        {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-       } // end of if(fCalculateDiffFlow) 
-       if(fCalculate2DDiffFlow)
-       {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-        if(m==0) // s_{p,k} does not depend on index m
-        {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-        } // end of if(m==0) // s_{p,k} does not depend on index m
-       } // end of if(fCalculate2DDiffFlow)
-      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     // Checking if RP particle is also POI particle:      
-     if(aftsTrack->InPOISelection())
-     {
-      // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
-      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-      {
-       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+       for(Int_t m=0;m<nHarmonicsDiff;m++)
        {
         if(fCalculateDiffFlow)
         {
          for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
          {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
+          fReRPQ1dEBE[rq][pe][m][k]->Fill(ptEta[pe],dWeightToPower[k]*dCos[m],1.);
+          fImRPQ1dEBE[rq][pe][m][k]->Fill(ptEta[pe],dWeightToPower[k]*dSin[m],1.);          
           if(m==0) // s_{p,k} does not depend on index m
           {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
+           fs1dEBE[rq][pe][k]->Fill(ptEta[pe],dWeightToPower[k],1.);
           } // end of if(m==0) // s_{p,k} does not depend on index m
          } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
         } // end of if(fCalculateDiffFlow) 
         if(fCalculate2DDiffFlow)
         {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
+         fReRPQ2dEBE[rq][m][k]->Fill(dPt,dEta,dWeightToPower[k]*dCos[m],1.);
+         fImRPQ2dEBE[rq][m][k]->Fill(dPt,dEta,dWeightToPower[k]*dSin[m],1.);      
          if(m==0) // s_{p,k} does not depend on index m
          {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
+          fs2dEBE[rq][k]->Fill(dPt,dEta,dWeightToPower[k],1.);
          } // end of if(m==0) // s_{p,k} does not depend on index m
         } // end of if(fCalculate2DDiffFlow)
-       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-     } // end of if(aftsTrack->InPOISelection())  
+       } // end of for(Int_t m=0;m<nHarmonicsDiff;m++)
+      } // end of for(Int_t k=0;k<nPowers;k++)
+     } // end of for(Int_t rq=0;rq<=2;rq+=2) // 0 = RP, 2 = RP && POI
     } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
-   } // end of if(pTrack->InRPSelection())
-   if(aftsTrack->InPOISelection())
+   } // end of if(qve->IsRP(i))
+   if(qve->IsPOI(i))
    {
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
     wPhi = 1.;
     wPt  = 1.;
     wEta = 1.;
     wTrack = 1.;
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && aftsTrack->InRPSelection()) // determine phi weight for POI && RP particle:
+    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && qve->IsRP(i)) // determine phi weight for POI && RP particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
     }
-    if(fUsePtWeights && fPtWeights && fnBinsPt && aftsTrack->InRPSelection()) // determine pt weight for POI && RP particle:
+    if(fUsePtWeights && fPtWeights && fnBinsPt && qve->IsRP(i)) // determine pt weight for POI && RP particle:
     {
      wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
     }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && aftsTrack->InRPSelection()) // determine eta weight for POI && RP particle: 
+    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && qve->IsRP(i)) // determine eta weight for POI && RP particle: 
     {
      wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
     }      
     // Access track weight for POI && RP particle:
-    if(aftsTrack->InRPSelection() && fUseTrackWeights)
+    if(qve->IsRP(i) && fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
+     wTrack = qve->GetWeight(i); 
     }
-    ptEta[0] = dPt;
-    ptEta[1] = dEta;
+    AliFlowQVectorEngine::WeightPowers(wPhi*wPt*wEta*wTrack,nPowers,dWeightToPower);
     // Calculate p_{m*n,k} ('p-vector' for POIs): 
-    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
-     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+     for(Int_t k=0;k<nPowers;k++)
      {
-      if(fCalculateDiffFlow)
+      for(Int_t m=0;m<nHarmonicsDiff;m++)
       {
-       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+       if(fCalculateDiffFlow)
        {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-      } // end of if(fCalculateDiffFlow) 
-      if(fCalculate2DDiffFlow)
-      {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-      } // end of if(fCalculate2DDiffFlow)
-     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-   } // end of if(pTrack->InPOISelection())    
-  } else // to if(aftsTrack)
+        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+        {
+         fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],dWeightToPower[k]*dCos[m],1.);
+         fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],dWeightToPower[k]*dSin[m],1.);          
+        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+       } // end of if(fCalculateDiffFlow) 
+       if(fCalculate2DDiffFlow)
+       {
+        fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,dWeightToPower[k]*dCos[m],1.);
+        fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,dWeightToPower[k]*dSin[m],1.);      
+       } // end of if(fCalculate2DDiffFlow)
+      } // end of for(Int_t m=0;m<nHarmonicsDiff;m++)
+     } // end of for(Int_t k=0;k<nPowers;k++)
+    } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)
+   } // end of if(qve->IsPOI(i))    
+  } else // to if(qve->HasTrack(i))
     {
      printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
     }
@@ -31,6 +31,7 @@ class TDirectoryFile;
 
 class AliFlowEventSimple;
 class AliFlowVector;
+class AliFlowQVectorEngine;
 
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
@@ -587,6 +588,7 @@ class AliFlowAnalysisWithQCumulants{
   TString *fAnalysisLabel; // analysis label (all histograms and output file will have this label)
   Bool_t fPrintFinalResults[4]; // print on the screen the final results (0=RF, 1=RP, 2=POI, 3=RF rebinned in M)
   Int_t fMaxCommonResultsHistogram; // can be [2468], e.g. if set to 2, AliFlowCommonHistResults[468]thOrderQC won't be booked
+  AliFlowQVectorEngine *fQVectorEngine; //! copy of phi, pt, eta, weight and RP/POI flags of the tracks of the current event
   
   // 2a.) particle weights:
   TList *fWeightsList; // list to hold all histograms with particle weights: fUseParticleWeights, fPhiWeights, fPtWeights and fEtaWeights
@@ -847,7 +849,7 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 5);
 
 };
 
@@ -0,0 +1,151 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  * 
+**************************************************************************/
+
+#include "AliFlowQVectorEngine.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackSimple.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Structure-of-arrays copy of the tracks of an AliFlowEventSimple   *
+// and the static per-track kernels needed to build Q-vectors.       *
+//                                                                   *
+// cos(h*phi) and sin(h*phi) are obtained for all h from a single    *
+// sin/cos evaluation using the angle addition theorems              *
+//   cos((h+1)phi) = cos(h*phi)cos(phi) - sin(h*phi)sin(phi)         *
+//   sin((h+1)phi) = sin(h*phi)cos(phi) + cos(h*phi)sin(phi)         *
+// and w^k for all k by successive multiplication, instead of one    *
+// TMath::Cos/Sin and pow() call per harmonic and power.             *
+//********************************************************************
+
+ClassImp(AliFlowQVectorEngine)
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::AliFlowQVectorEngine():
+ TObject(),
+ fNTracks(0),
+ fTrackCapacity(0),
+ fPhi(NULL),
+ fPt(NULL),
+ fEta(NULL),
+ fWeight(NULL),
+ fFlags(NULL)
+{
+ // default constructor
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorEngine::~AliFlowQVectorEngine()
+{
+ // destructor
+ delete [] fPhi;
+ delete [] fPt;
+ delete [] fEta;
+ delete [] fWeight;
+ delete [] fFlags;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::ReserveTracks(Int_t nTracks)
+{
+ // Make room for nTracks tracks, the arrays only grow.
+ 
+ if(nTracks <= fTrackCapacity){return;}
+ 
+ delete [] fPhi;
+ delete [] fPt;
+ delete [] fEta;
+ delete [] fWeight;
+ delete [] fFlags;
+ fTrackCapacity = TMath::Max(nTracks,2*fTrackCapacity);
+ fPhi = new Double_t[fTrackCapacity];
+ fPt = new Double_t[fTrackCapacity];
+ fEta = new Double_t[fTrackCapacity];
+ fWeight = new Double_t[fTrackCapacity];
+ fFlags = new UChar_t[fTrackCapacity];
+}
+
+//________________________________________________________________________
+
+Int_t AliFlowQVectorEngine::LoadEvent(AliFlowEventSimple *anEvent)
+{
+ // Copy the kinematics, track weight and RP/POI flags of all tracks of anEvent.
+ // Returns the number of tracks, missing tracks are kept with HasTrack() == kFALSE.
+ 
+ fNTracks = 0;
+ if(!anEvent){return 0;}
+ 
+ Int_t nTracks = anEvent->NumberOfTracks();
+ ReserveTracks(nTracks);
+ for(Int_t i=0;i<nTracks;i++)
+ {
+  AliFlowTrackSimple *pTrack = anEvent->GetTrack(i);
+  fFlags[i] = 0;
+  if(!pTrack)
+  {
+   fPhi[i] = 0.; fPt[i] = 0.; fEta[i] = 0.; fWeight[i] = 1.;
+   continue;
+  }
+  fPhi[i] = pTrack->Phi();
+  fPt[i] = pTrack->Pt();
+  fEta[i] = pTrack->Eta();
+  fWeight[i] = pTrack->Weight();
+  fFlags[i] = kHasTrack;
+  if(pTrack->InRPSelection()){fFlags[i] |= kRP;}
+  if(pTrack->InPOISelection()){fFlags[i] |= kPOI;}
+ } // end of for(Int_t i=0;i<nTracks;i++)
+ fNTracks = nTracks;
+ 
+ return fNTracks;
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::CosSinMultiples(Double_t angle, Int_t nHarmonics, Double_t *cosMultiples, Double_t *sinMultiples)
+{
+ // cosMultiples[h-1] = cos(h*angle), sinMultiples[h-1] = sin(h*angle) for h = 1,...,nHarmonics.
+ // The rounding error grows linearly with h, i.e. it stays at the level of a few 1e-15 for the harmonics in use.
+ 
+ if(nHarmonics <= 0){return;}
+ 
+ Double_t c1 = TMath::Cos(angle);
+ Double_t s1 = TMath::Sin(angle);
+ cosMultiples[0] = c1;
+ sinMultiples[0] = s1;
+ for(Int_t h=1;h<nHarmonics;h++)
+ {
+  cosMultiples[h] = cosMultiples[h-1]*c1 - sinMultiples[h-1]*s1;
+  sinMultiples[h] = sinMultiples[h-1]*c1 + cosMultiples[h-1]*s1;
+ }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorEngine::WeightPowers(Double_t w, Int_t nPowers, Double_t *wToPower)
+{
+ // wToPower[k] = w^k for k = 0,...,nPowers-1.
+ 
+ if(nPowers <= 0){return;}
+ 
+ wToPower[0] = 1.;
+ for(Int_t k=1;k<nPowers;k++)
+ {
+  wToPower[k] = wToPower[k-1]*w;
+ }
+}
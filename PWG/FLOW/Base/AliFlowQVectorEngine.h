@@ -0,0 +1,61 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORENGINE_H
+#define ALIFLOWQVECTORENGINE_H
+
+#include "TObject.h"
+
+//********************************************************************
+// AliFlowQVectorEngine:                                             *
+// Structure-of-arrays copy of the tracks of an AliFlowEventSimple,  *
+// filled once per event by LoadEvent(), and static kernels which    *
+// give cos/sin of all multiples of an angle from a single sincos    *
+// and all powers of a particle weight. Used by                      *
+// AliFlowAnalysisWithQCumulants to build its Q-vectors.             *
+//********************************************************************
+
+class AliFlowEventSimple;
+
+class AliFlowQVectorEngine: public TObject {
+ public:
+  AliFlowQVectorEngine();
+  virtual ~AliFlowQVectorEngine();
+
+  // Copy phi, pt, eta, track weight and RP/POI flags of all tracks:
+  Int_t LoadEvent(AliFlowEventSimple *anEvent);
+  Int_t GetNumberOfTracks() const {return fNTracks;};
+  Bool_t   HasTrack(Int_t i) const {return fFlags[i] & kHasTrack;};
+  Bool_t   IsRP(Int_t i) const {return fFlags[i] & kRP;};
+  Bool_t   IsPOI(Int_t i) const {return fFlags[i] & kPOI;};
+  Double_t GetPhi(Int_t i) const {return fPhi[i];};
+  Double_t GetPt(Int_t i) const {return fPt[i];};
+  Double_t GetEta(Int_t i) const {return fEta[i];};
+  Double_t GetWeight(Int_t i) const {return fWeight[i];};
+
+  // Kernels, called per track with caller owned arrays:
+  // cos(h*angle), sin(h*angle) for h = 1,...,nHarmonics and w^k for k = 0,...,nPowers-1
+  static void CosSinMultiples(Double_t angle, Int_t nHarmonics, Double_t *cosMultiples, Double_t *sinMultiples);
+  static void WeightPowers(Double_t w, Int_t nPowers, Double_t *wToPower);
+
+ private:
+  AliFlowQVectorEngine(const AliFlowQVectorEngine& aEngine);
+  AliFlowQVectorEngine& operator=(const AliFlowQVectorEngine& aEngine);
+
+  void ReserveTracks(Int_t nTracks);
+
+  enum ETrackFlags {kHasTrack=BIT(0), kRP=BIT(1), kPOI=BIT(2)};
+
+  Int_t fNTracks;           //! number of tracks of the current event
+  Int_t fTrackCapacity;     //! allocated size of the track arrays
+  Double_t *fPhi;           //! [fTrackCapacity] azimuthal angle
+  Double_t *fPt;            //! [fTrackCapacity] transverse momentum
+  Double_t *fEta;           //! [fTrackCapacity] pseudorapidity
+  Double_t *fWeight;        //! [fTrackCapacity] track weight
+  UChar_t *fFlags;          //! [fTrackCapacity] ETrackFlags
+
+  ClassDef(AliFlowQVectorEngine,1) // Q-vector builder
+};
+
+#endif
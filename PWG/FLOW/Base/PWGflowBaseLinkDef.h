@@ -8,6 +8,7 @@
 #pragma link C++ namespace AliFlowLYZConstants;
 
 #pragma link C++ class AliFlowVector+;
+#pragma link C++ class AliFlowQVectorEngine+;
 #pragma link C++ class AliFlowTrackSimple+;
 #pragma link C++ class AliFlowEventSimple+;
 
@@ -0,0 +1,230 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include "AliEmcalJetMatchingGrid.h"
+
+#include <algorithm>
+
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliEmcalJet.h"
+#include "AliJetContainer.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalJetMatchingGrid);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalJetMatchingGrid::AliEmcalJetMatchingGrid() :
+  fRadius(-1),
+  fBuilt(kFALSE),
+  fEtaMin(0),
+  fEtaCellWidth(0),
+  fPhiCellWidth(0),
+  fNEtaCells(0),
+  fNPhiCells(0),
+  fJets(),
+  fEta(),
+  fPhi(),
+  fCellFirst(),
+  fCellJets(),
+  fAlwaysCandidates(),
+  fCandidates()
+{
+}
+
+/**
+ * Remove all jets and set the search radius. A radius <= 0
+ * disables the pre-selection, i.e. all jets are returned as candidates.
+ * @param radius Search radius in (eta, phi)
+ */
+void AliEmcalJetMatchingGrid::Reset(Double_t radius)
+{
+  fRadius = radius;
+  fBuilt = kFALSE;
+  fJets.clear();
+  fEta.clear();
+  fPhi.clear();
+  fCellFirst.clear();
+  fCellJets.clear();
+  fAlwaysCandidates.clear();
+  fCandidates.clear();
+  fNEtaCells = 0;
+  fNPhiCells = 0;
+}
+
+/**
+ * Add a jet to the grid. Build() must be called (again) before searching.
+ * @param jet Jet to be added
+ */
+void AliEmcalJetMatchingGrid::AddJet(AliEmcalJet *jet)
+{
+  if (!jet) return;
+  fJets.push_back(jet);
+  fEta.push_back(jet->Eta());
+  fPhi.push_back(jet->Phi());
+  fBuilt = kFALSE;
+}
+
+/**
+ * Reset the grid and add all accepted jets of a jet container,
+ * in the order of AliJetContainer::GetNextJet().
+ * @param jets Jet container
+ * @param radius Search radius in (eta, phi)
+ * @return Number of jets in the grid
+ */
+Int_t AliEmcalJetMatchingGrid::Fill(AliJetContainer *jets, Double_t radius)
+{
+  Reset(radius);
+  if (!jets) return 0;
+
+  AliEmcalJet *jet = 0;
+  jets->ResetCurrentID();
+  while ((jet = jets->GetNextJet())) AddJet(jet);
+
+  Build();
+
+  return fJets.size();
+}
+
+/**
+ * Sort the jets into the (eta, phi) cells.
+ */
+void AliEmcalJetMatchingGrid::Build()
+{
+  fBuilt = kTRUE;
+  fCellFirst.clear();
+  fCellJets.clear();
+  fAlwaysCandidates.clear();
+  fNEtaCells = 0;
+  fNPhiCells = 0;
+
+  if (fRadius <= 0) return;
+
+  Int_t nJets = fJets.size();
+  Double_t etaMax = 0;
+  Bool_t first = kTRUE;
+  for (Int_t i = 0; i < nJets; i++) {
+    if (!TMath::Finite(fEta[i]) || !TMath::Finite(fPhi[i])) continue;
+    if (first || fEta[i] < fEtaMin) fEtaMin = fEta[i];
+    if (first || fEta[i] > etaMax) etaMax = fEta[i];
+    first = kFALSE;
+  }
+  if (first) fEtaMin = etaMax = 0;
+
+  fEtaCellWidth = fRadius;
+  fNEtaCells = TMath::FloorNint((etaMax - fEtaMin) / fEtaCellWidth) + 1;
+  fNPhiCells = TMath::Max(1, TMath::FloorNint(TMath::TwoPi() / fRadius));
+  fPhiCellWidth = TMath::TwoPi() / fNPhiCells;
+
+  // counting sort of the jets into the cells, keeping the order of the jets within a cell
+  Int_t nCells = fNEtaCells * fNPhiCells;
+  std::vector<Int_t> cell(nJets, -1);
+  fCellFirst.assign(nCells + 1, 0);
+  for (Int_t i = 0; i < nJets; i++) {
+    if (!TMath::Finite(fEta[i]) || !TMath::Finite(fPhi[i])) {
+      fAlwaysCandidates.push_back(i);
+      continue;
+    }
+    cell[i] = EtaCell(fEta[i]) * fNPhiCells + PhiCell(fPhi[i]);
+    fCellFirst[cell[i] + 1]++;
+  }
+  for (Int_t c = 0; c < nCells; c++) fCellFirst[c + 1] += fCellFirst[c];
+
+  fCellJets.resize(fCellFirst[nCells]);
+  std::vector<Int_t> fillPos(fCellFirst.begin(), fCellFirst.end() - 1);
+  for (Int_t i = 0; i < nJets; i++) {
+    if (cell[i] < 0) continue;
+    fCellJets[fillPos[cell[i]]++] = i;
+  }
+}
+
+/**
+ * Find all jets within the search radius of a given axis.
+ * The same distance as in AliEmcalJet::DeltaR() is used.
+ * @param eta Pseudorapidity of the axis
+ * @param phi Azimuthal angle of the axis
+ * @return Number of candidates, to be retrieved with GetCandidate()
+ */
+Int_t AliEmcalJetMatchingGrid::FindCandidates(Double_t eta, Double_t phi)
+{
+  if (!fBuilt) Build();
+
+  fCandidates.clear();
+
+  Int_t nJets = fJets.size();
+  if (fRadius <= 0 || !TMath::Finite(eta) || !TMath::Finite(phi)) {
+    for (Int_t i = 0; i < nJets; i++) fCandidates.push_back(i);
+    return fCandidates.size();
+  }
+
+  Int_t ieta = TMath::FloorNint((eta - fEtaMin) / fEtaCellWidth);
+  Int_t iphi = PhiCell(phi);
+  for (Int_t jeta = TMath::Max(0, ieta - 1); jeta <= TMath::Min(fNEtaCells - 1, ieta + 1); jeta++) {
+    if (fNPhiCells < 3) {
+      for (Int_t jphi = 0; jphi < fNPhiCells; jphi++) AddCellCandidates(jeta, jphi, eta, phi);
+    }
+    else {
+      AddCellCandidates(jeta, (iphi + fNPhiCells - 1) % fNPhiCells, eta, phi);
+      AddCellCandidates(jeta, iphi, eta, phi);
+      AddCellCandidates(jeta, (iphi + 1) % fNPhiCells, eta, phi);
+    }
+  }
+  fCandidates.insert(fCandidates.end(), fAlwaysCandidates.begin(), fAlwaysCandidates.end());
+
+  // restore the order in which the jets were added
+  std::sort(fCandidates.begin(), fCandidates.end());
+
+  return fCandidates.size();
+}
+
+/**
+ * Add the jets of a cell which are within the search radius.
+ */
+void AliEmcalJetMatchingGrid::AddCellCandidates(Int_t ieta, Int_t iphi, Double_t eta, Double_t phi)
+{
+  Int_t c = ieta * fNPhiCells + iphi;
+  for (Int_t k = fCellFirst[c]; k < fCellFirst[c + 1]; k++) {
+    Int_t i = fCellJets[k];
+    Double_t dPhi = TVector2::Phi_mpi_pi(phi - fPhi[i]);
+    Double_t dEta = eta - fEta[i];
+    if (TMath::Sqrt(dPhi * dPhi + dEta * dEta) > fRadius) continue;
+    fCandidates.push_back(i);
+  }
+}
+
+/**
+ * Eta cell of a jet inside the eta range of the grid.
+ */
+Int_t AliEmcalJetMatchingGrid::EtaCell(Double_t eta) const
+{
+  Int_t ieta = TMath::FloorNint((eta - fEtaMin) / fEtaCellWidth);
+  if (ieta < 0) ieta = 0;
+  if (ieta >= fNEtaCells) ieta = fNEtaCells - 1;
+  return ieta;
+}
+
+/**
+ * Phi cell, phi is mapped to [0, 2pi).
+ */
+Int_t AliEmcalJetMatchingGrid::PhiCell(Double_t phi) const
+{
+  Int_t iphi = TMath::FloorNint(TVector2::Phi_0_2pi(phi) / fPhiCellWidth);
+  if (iphi < 0) iphi = 0;
+  if (iphi >= fNPhiCells) iphi = fNPhiCells - 1;
+  return iphi;
+}
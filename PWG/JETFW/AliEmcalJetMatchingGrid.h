@@ -0,0 +1,81 @@
+#ifndef ALIEMCALJETMATCHINGGRID_H
+#define ALIEMCALJETMATCHINGGRID_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class AliEmcalJet;
+class AliJetContainer;
+
+/**
+ * \class AliEmcalJetMatchingGrid
+ * \brief Geometrical pre-selection of jet matching candidates
+ *
+ * The jets of one collection are sorted into a grid in (eta, phi) with a cell size
+ * of at least the matching radius, phi being periodic. For a given jet axis only the
+ * jets in the neighbouring cells are tested, which makes the search for matching
+ * partners linear in the number of jets instead of quadratic.
+ *
+ * Candidates are returned in the order in which the jets were added, such that a
+ * matching loop over the candidates gives the same result as the loop over the full
+ * collection for all pairs closer than the radius. Jets with a non-finite axis are
+ * always returned as candidates.
+ *
+ * ~~~{.cxx}
+ * grid.Fill(jets2, 0.3);
+ * for (auto jet1 : jets1->accepted()) {
+ *   Int_t n = grid.FindCandidates(jet1->Eta(), jet1->Phi());
+ *   for (Int_t i = 0; i < n; i++) Match(jet1, grid.GetCandidate(i));
+ * }
+ * ~~~
+ *
+ * \date Oct 18, 2026
+ */
+class AliEmcalJetMatchingGrid {
+ public:
+  AliEmcalJetMatchingGrid();
+  virtual ~AliEmcalJetMatchingGrid() {}
+
+  void                Reset(Double_t radius);
+  void                AddJet(AliEmcalJet *jet);
+  void                Build();
+  Int_t               Fill(AliJetContainer *jets, Double_t radius);
+
+  Int_t               FindCandidates(Double_t eta, Double_t phi);
+  Int_t               GetNumberOfCandidates()            const { return fCandidates.size()    ; }
+  AliEmcalJet        *GetCandidate(Int_t i)              const { return fJets[fCandidates[i]] ; }
+  Int_t               GetNumberOfJets()                  const { return fJets.size()          ; }
+  Double_t            GetRadius()                        const { return fRadius               ; }
+
+ protected:
+  Int_t               EtaCell(Double_t eta)              const;
+  Int_t               PhiCell(Double_t phi)              const;
+  void                AddCellCandidates(Int_t ieta, Int_t iphi, Double_t eta, Double_t phi);
+
+  Double_t            fRadius;                 //!<! search radius in (eta, phi)
+  Bool_t              fBuilt;                  //!<! whether the cell index is up to date
+  Double_t            fEtaMin;                 //!<! lower edge of the eta range of the grid
+  Double_t            fEtaCellWidth;           //!<! eta width of a cell
+  Double_t            fPhiCellWidth;           //!<! phi width of a cell
+  Int_t               fNEtaCells;              //!<! number of cells in eta
+  Int_t               fNPhiCells;              //!<! number of cells in phi
+  std::vector<AliEmcalJet*> fJets;             //!<! jets in the order they were added
+  std::vector<Double_t> fEta;                  //!<! eta of the jets
+  std::vector<Double_t> fPhi;                  //!<! phi of the jets, in [0, 2pi)
+  std::vector<Int_t>  fCellFirst;              //!<! first entry of each cell in fCellJets, size = number of cells + 1
+  std::vector<Int_t>  fCellJets;               //!<! jet indices ordered by cell
+  std::vector<Int_t>  fAlwaysCandidates;       //!<! jets with a non-finite axis
+  std::vector<Int_t>  fCandidates;             //!<! candidates of the last search, in ascending order
+
+ private:
+  AliEmcalJetMatchingGrid(const AliEmcalJetMatchingGrid&);            // not implemented
+  AliEmcalJetMatchingGrid& operator=(const AliEmcalJetMatchingGrid&); // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalJetMatchingGrid, 1); // Geometrical pre-selection of jet matching candidates
+  /// \endcond
+};
+#endif
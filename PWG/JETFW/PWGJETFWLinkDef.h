@@ -15,6 +15,7 @@
 #pragma link C++ class std::map<std::string, AliJetContainer*>+;
 #pragma link C++ class std::pair<std::string, AliJetContainer*>+;
 #pragma link C++ class AliDJetVReader+;
+#pragma link C++ class AliEmcalJetMatchingGrid+;
 
 #pragma link C++ namespace PWG+;
 #pragma link C++ namespace PWG::JETFW+;
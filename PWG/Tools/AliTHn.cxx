@@ -53,7 +53,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fXbinsCache(0)
 {
   // Constructor
 }
@@ -69,7 +72,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fXbinsCache(0)
 {
   // Constructor
 
@@ -106,7 +112,10 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fXminCache(0),
+  fXmaxCache(0),
+  fXbinsCache(0)
 {
   //
   // AliTHnT copy constructor
@@ -131,10 +140,29 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   
   delete[] fValues;
   delete[] fSumw2;
+  DeleteBinCache();
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteBinCache()
+{
+  // delete the axis and bin caches, they are recreated by the next Fill
+
   delete[] axisCache;
   delete[] fNbinsCache;
   delete[] fLastVars;
   delete[] fLastBins;
+  delete[] fXminCache;
+  delete[] fXmaxCache;
+  delete[] fXbinsCache;
+
+  axisCache = 0;
+  fNbinsCache = 0;
+  fLastVars = 0;
+  fLastBins = 0;
+  fXminCache = 0;
+  fXmaxCache = 0;
+  fXbinsCache = 0;
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -191,9 +219,8 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
       fValues = 0;
       fSumw2 = 0;
     }
-    delete [] axisCache;
-    axisCache = new TAxis*[fNVars];
-    memcpy(axisCache, c.axisCache, fNVars*sizeof(TAxis*));
+    // the axes of c are not used by this object, the caches are rebuilt with the next Fill
+    DeleteBinCache();
   }
   return *this;
 }
@@ -281,6 +308,36 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
   return count+1;
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitBinCache()
+{
+  // fills the axis cache
+
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  fXminCache = new Double_t[fNVars];
+  fXmaxCache = new Double_t[fNVars];
+  fXbinsCache = new const Double_t*[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+    fXminCache[i] = axisCache[i]->GetXmin();
+    fXmaxCache[i] = axisCache[i]->GetXmax();
+    fXbinsCache[i] = (axisCache[i]->GetXbins()->GetSize() > 0) ? axisCache[i]->GetXbins()->GetArray() : 0;
+  }
+  
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  
+  // initial values which never match a variable (NaN != NaN)
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    fLastBins[i] = 0;
+    fLastVars[i] = TMath::QuietNaN();
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
 {
@@ -288,25 +345,7 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 
   // fill axis cache
   if (!axisCache)
-  {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
-    }
-  }
+    InitBinCache();
   
   // calculate global bin index
   Long64_t bin = 0;
@@ -319,7 +358,7 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
       tmpBin = fLastBins[i];
     else
     {
-      tmpBin = axisCache[i]->FindBin(var[i]);
+      tmpBin = FindBinCached(i, var[i]);
       fLastBins[i] = tmpBin;
       fLastVars[i] = var[i];
     }
@@ -334,6 +373,94 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //     Printf("%lld", bin);
   }
 
+  AddToBin(istep, bin, weight);
+  
+  // debug
+//   AliCFContainer::Fill(var, istep, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(Int_t n, const Double_t *var, const Int_t *istep, const Double_t *weight)
+{
+  // fills <n> entries
+  // var contains the variables of the entries one after the other (n * number of variables)
+  // istep and weight contain one value per entry, weight = 0 means weight 1 for all entries
+  //
+  // the global bins are computed axis by axis for blocks of entries, which avoids
+  // the per-entry FindBin calls and keeps the inner loops free of function calls
+
+  if (n <= 0)
+    return;
+
+  if (!axisCache)
+    InitBinCache();
+
+  const Int_t kBlock = 256;
+  Long64_t bins[kBlock];
+
+  for (Int_t first=0; first<n; first+=kBlock)
+  {
+    const Int_t nBlock = TMath::Min(kBlock, n - first);
+    const Double_t* blockVar = var + (Long64_t) first * fNVars;
+
+    for (Int_t j=0; j<nBlock; j++)
+      bins[j] = 0;
+
+    for (Int_t i=0; i<fNVars; i++)
+    {
+      const Int_t nBins = fNbinsCache[i];
+      const Double_t xMin = fXminCache[i];
+      const Double_t xMax = fXmaxCache[i];
+      const Double_t* xBins = fXbinsCache[i];
+
+      for (Int_t j=0; j<nBlock; j++)
+      {
+        // entry already outside the histogram
+        if (bins[j] < 0)
+          continue;
+
+        const Double_t x = blockVar[(Long64_t) j * fNVars + i];
+
+        // under/overflow not supported
+        if (x < xMin || !(x < xMax))
+        {
+          bins[j] = -1;
+          continue;
+        }
+
+        Int_t tmpBin = 0;
+        if (!xBins)
+          tmpBin = Int_t(nBins * (x - xMin) / (xMax - xMin));
+        else
+          tmpBin = TMath::BinarySearch(nBins + 1, xBins, x);
+
+        // can happen at the upper edge for variable bins
+        if (tmpBin < 0 || tmpBin >= nBins)
+        {
+          bins[j] = -1;
+          continue;
+        }
+
+        bins[j] = bins[j] * nBins + tmpBin;
+      }
+    }
+
+    for (Int_t j=0; j<nBlock; j++)
+    {
+      if (bins[j] < 0)
+        continue;
+
+      const Double_t w = (weight) ? weight[first + j] : 1.;
+      AddToBin(istep[first + j], bins[j], w);
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::AddToBin(Int_t istep, Long64_t bin, Double_t weight)
+{
+  // adds weight to the global bin <bin> of step <istep>
+
   if (!fValues[istep])
   {
     fValues[istep] = new TemplateArray(fNBins);
@@ -355,9 +482,6 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
     fSumw2[istep]->GetArray()[bin] += weight * weight;
   
 //   Printf("%f", fValues[istep][bin]);
-  
-  // debug
-//   AliCFContainer::Fill(var, istep, weight);
 }
 
 template <class TemplateArray, typename TemplateType>
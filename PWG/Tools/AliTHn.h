@@ -12,6 +12,7 @@
 
 #include "TObject.h"
 #include "TString.h"
+#include "TMath.h"
 #include "AliCFContainer.h"
 
 class TArray;
@@ -26,6 +27,13 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void Fill(Int_t n, const Double_t *var, const Int_t *istep, const Double_t *weight=0)
+  {
+    // fills <n> entries, var contains the variables of the entries one after the other
+    const Int_t nVars = GetNVar();
+    for (Int_t j=0; j<n; j++)
+      Fill(var + (Long64_t) j * nVars, istep[j], (weight) ? weight[j] : 1.);
+  }
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,6 +56,7 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void Fill(Int_t n, const Double_t *var, const Int_t *istep, const Double_t *weight=0);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -65,7 +74,22 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitBinCache();
+  void DeleteBinCache();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  void AddToBin(Int_t istep, Long64_t bin, Double_t weight);
+
+  // same result as TAxis::FindBin, without the virtual call and extendable axis handling
+  Int_t FindBinCached(Int_t i, Double_t x) const
+  {
+    if (x < fXminCache[i])
+      return 0;
+    if (!(x < fXmaxCache[i]))
+      return fNbinsCache[i] + 1;
+    if (!fXbinsCache[i])
+      return 1 + Int_t(fNbinsCache[i] * (x - fXminCache[i]) / (fXmaxCache[i] - fXminCache[i]));
+    return 1 + TMath::BinarySearch(fNbinsCache[i] + 1, fXbinsCache[i], x);
+  }
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
@@ -77,6 +101,9 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Double_t* fXminCache; //! cache lower edge per axis
+  Double_t* fXmaxCache; //! cache upper edge per axis
+  const Double_t** fXbinsCache; //! cache variable bin edges per axis (0 for uniform binning)
   
   ClassDef(AliTHnT, 5) // THn like container
 };
@@ -46,4 +46,5 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandles();
 #endif
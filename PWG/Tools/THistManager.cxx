@@ -15,7 +15,6 @@
 #include <cfloat>
 #include <cstring>
 #include <iostream>   // for unit tests
-#include <sstream>
 #include <string>
 #include <exception>
 #include <vector>
@@ -42,14 +41,16 @@ ClassImp(THistManager)
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fFillCache()
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fFillCache()
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -77,13 +78,13 @@ THashList* THistManager::CreateHistoGroup(const char *groupname) {
 	return childgroup;
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt){
+THistHandle<TH1> THistManager::CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH1", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH1>();
 	}
 	TH1* h = new TH1D(hname, title, nbins, xmin, xmax);
   TString optionstring(opt);
@@ -91,16 +92,16 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, dou
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH1>(h, DecodeWidthAxes(opt, 1));
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt){
+THistHandle<TH1> THistManager::CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH1", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH1>();
 	}
 	TH1* h = new TH1D(hname, title, nbins, xbins);
   TString optionstring(opt);
@@ -108,16 +109,16 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, int nbins, con
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH1>(h, DecodeWidthAxes(opt, 1));
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt){
+THistHandle<TH1> THistManager::CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH1", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH1>();
 	}
 	TH1* h = new TH1D(hname, title, xbins.GetSize()-1, xbins.GetArray());
   TString optionstring(opt);
@@ -125,10 +126,10 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, const TArrayD
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH1>(h, DecodeWidthAxes(opt, 1));
 }
 
-TH1* THistManager::CreateTH1(const char *name, const char *title, const TBinning &xbin, Option_t *opt){
+THistHandle<TH1> THistManager::CreateTH1(const char *name, const char *title, const TBinning &xbin, Option_t *opt){
   TArrayD myxbins;
   try{
     xbin.CreateBinEdges(myxbins);
@@ -138,13 +139,13 @@ TH1* THistManager::CreateTH1(const char *name, const char *title, const TBinning
   return CreateTH1(name, title, myxbins, opt);
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt){
+THistHandle<TH2> THistManager::CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH2", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH2>();
 	}
 	TH2* h = new TH2D(hname, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax);
   TString optionstring(opt);
@@ -152,16 +153,16 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, do
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH2>(h, DecodeWidthAxes(opt, 2));
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt){
+THistHandle<TH2> THistManager::CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH2", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH2>();
 	}
 	TH2* h = new TH2D(hname, title, nbinsx, xbins, nbinsy, ybins);
   TString optionstring(opt);
@@ -169,16 +170,16 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, int nbinsx, co
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH2>(h, DecodeWidthAxes(opt, 2));
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt){
+THistHandle<TH2> THistManager::CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt){
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH2", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH2>();
 	}
 	TH2* h = new TH2D(hname, title, xbins.GetSize() - 1, xbins.GetArray(), ybins.GetSize() - 1, ybins.GetArray());
   TString optionstring(opt);
@@ -186,10 +187,10 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, const TArrayD
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH2>(h, DecodeWidthAxes(opt, 2));
 }
 
-TH2* THistManager::CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt){
+THistHandle<TH2> THistManager::CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt){
   TArrayD myxbins, myybins;
   try{
     xbins.CreateBinEdges(myxbins);
@@ -205,13 +206,13 @@ TH2* THistManager::CreateTH2(const char *name, const char *title, const TBinning
   return CreateTH2(name, title, myxbins, myybins, opt);
 }
 
-TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt) {
+THistHandle<TH3> THistManager::CreateTH3(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH3", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH3>();
 	}
 	TH3* h = new TH3D(hname, title, nbinsx, xmin, xmax, nbinsy, ymin, ymax, nbinsz, zmin, zmax);
   TString optionstring(opt);
@@ -219,16 +220,16 @@ TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, do
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH3>(h, DecodeWidthAxes(opt, 3));
 }
 
-TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, const double* xbins, int nbinsy, const double* ybins, int nbinsz, const double* zbins, Option_t *opt) {
+THistHandle<TH3> THistManager::CreateTH3(const char* name, const char* title, int nbinsx, const double* xbins, int nbinsy, const double* ybins, int nbinsz, const double* zbins, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH3", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH3>();
   }
 	TH3* h = new TH3D(hname, title, nbinsx, xbins, nbinsy, ybins, nbinsz, zbins);
   TString optionstring(opt);
@@ -236,16 +237,16 @@ TH3* THistManager::CreateTH3(const char* name, const char* title, int nbinsx, co
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH3>(h, DecodeWidthAxes(opt, 3));
 }
 
-TH3* THistManager::CreateTH3(const char* name, const char* title, const TArrayD& xbins, const TArrayD& ybins, const TArrayD& zbins, Option_t *opt) {
+THistHandle<TH3> THistManager::CreateTH3(const char* name, const char* title, const TArrayD& xbins, const TArrayD& ybins, const TArrayD& zbins, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTH3", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<TH3>();
 	}
 	TH3* h = new TH3D(hname, title, xbins.GetSize()-1, xbins.GetArray(), ybins.GetSize()-1, ybins.GetArray(), zbins.GetSize()-1, zbins.GetArray());
   TString optionstring(opt);
@@ -253,10 +254,10 @@ TH3* THistManager::CreateTH3(const char* name, const char* title, const TArrayD&
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<TH3>(h, DecodeWidthAxes(opt, 3));
 }
 
-TH3* THistManager::CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt){
+THistHandle<TH3> THistManager::CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt){
   TArrayD myxbins, myybins, myzbins;
   try{
     xbins.CreateBinEdges(myxbins);
@@ -274,16 +275,16 @@ TH3* THistManager::CreateTH3(const char *name, const char *title, const TBinning
     Fatal("THistManager::CreateTH2 (z-dir)", "Exception raised: %s", e.what());
   }
 
-  return CreateTH3(name, title, myxbins, myybins, myzbins);
+  return CreateTH3(name, title, myxbins, myybins, myzbins, opt);
 }
 
-THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt) {
+THistHandle<THnSparse> THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<THnSparse>();
 	}
 	THnSparse* h = new THnSparseD(hname, title, ndim, nbins, min, max);
   TString optionstring(opt);
@@ -291,16 +292,16 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   if(optionstring.Contains("s"))
     h->Sumw2();
 	parent->Add(h);
-	return h;
+	return THistHandle<THnSparse>(h, DecodeWidthAxes(opt, ndim, true));
 }
 
-THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt) {
+THistHandle<THnSparse> THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt) {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) parent = CreateHistoGroup(dirname);
 	if(parent->FindObject(hname)){
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-		return 0;
+		return THistHandle<THnSparse>();
 	}
 	TArrayD xmin(ndim), xmax(ndim);
 	TArrayI nbins(ndim);
@@ -318,16 +319,16 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   if(optionstring.Contains("s"))
     hsparse->Sumw2();
 	parent->Add(hsparse);
-	return hsparse;
+	return THistHandle<THnSparse>(hsparse, DecodeWidthAxes(opt, ndim, true));
 }
 
-THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt){
+THistHandle<THnSparse> THistManager::CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
   if(parent->FindObject(hname)){
     Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
-    return 0;
+    return THistHandle<THnSparse>();
   }
   TArrayD xmin(ndim), xmax(ndim);
   TArrayI nbins(ndim);
@@ -351,10 +352,10 @@ THnSparse* THistManager::CreateTHnSparse(const char *name, const char *title, in
   if(optionstring.Contains("s"))
     hsparse->Sumw2();
   parent->Add(hsparse);
-  return hsparse;
+  return THistHandle<THnSparse>(hsparse, DecodeWidthAxes(opt, ndim, true));
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
+THistHandle<TProfile> THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, double xmin, double xmax, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -362,9 +363,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTProfile", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xmin, xmax, opt);
   parent->Add(hist);
+  return THistHandle<TProfile>(hist);
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
+THistHandle<TProfile> THistManager::CreateTProfile(const char* name, const char* title, int nbinsX, const double* xbins, Option_t *opt) {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -372,9 +374,10 @@ void THistManager::CreateTProfile(const char* name, const char* title, int nbins
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname, title, nbinsX, xbins, opt);
   parent->Add(hist);
+  return THistHandle<TProfile>(hist);
 }
 
-void THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
+THistHandle<TProfile> THistManager::CreateTProfile(const char* name, const char* title, const TArrayD& xbins, Option_t *opt){
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
   if(!parent) parent = CreateHistoGroup(dirname);
@@ -382,16 +385,17 @@ void THistManager::CreateTProfile(const char* name, const char* title, const TAr
 		Fatal("THistManager::CreateTHnSparse", "Object %s already exists in group %s", hname.Data(), dirname.Data());
   TProfile *hist = new TProfile(hname.Data(), title, xbins.GetSize()-1, xbins.GetArray(), opt);
   parent->Add(hist);
+  return THistHandle<TProfile>(hist);
 }
 
-void THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
+THistHandle<TProfile> THistManager::CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt){
   TArrayD myxbins;
   try{
     xbins.CreateBinEdges(myxbins);
   } catch (std::exception &e){
     Fatal("THistManager::CreateProfile", "Exception raised: %s", e.what());
   }
-  CreateTProfile(name, title, myxbins, opt);
+  return CreateTProfile(name, title, myxbins, opt);
 }
 
 void THistManager::SetObject(TObject * const o, const char *group) {
@@ -409,15 +413,9 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+	TH1 *hist = dynamic_cast<TH1 *>(FindFillTarget(name, "THistManager::FillTH1"));
 	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
 		return;
 	}
 	TString optionstring(opt);
@@ -432,15 +430,9 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+  TH1 *hist = dynamic_cast<TH1 *>(FindFillTarget(name, "THistManager::FillTH1"));
   if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
     return;
   }
 	TString optionstring(opt);
@@ -456,175 +448,153 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+	TH2 *hist = dynamic_cast<TH2 *>(FindFillTarget(name, "THistManager::FillTH2"));
 	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	UInt_t widthaxes = DecodeWidthAxes(opt, 2);
+	if(widthaxes){
+	  weight = 1.;
+	  if(widthaxes & 1) weight *= InverseBinWidth(hist->GetXaxis(), x);
+	  if(widthaxes & 2) weight *= InverseBinWidth(hist->GetYaxis(), y);
 	}
-	hist->Fill(x, y, myweight);
+	hist->Fill(x, y, weight);
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(point[0], point[1], weight);
+	FillTH2(name, point[0], point[1], weight, opt);
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+  TH2 *hist = dynamic_cast<TH2 *>(FindFillTarget(name, "THistManager::FillTH2"));
   if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
     return;
   }
-  TString optstring(opt);
-  Double_t myweight = optstring.Contains("w") ? 1. : weight;
-  if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-  }
-  if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+  UInt_t widthaxes = DecodeWidthAxes(opt, 2);
+  if(widthaxes){
+    weight = 1.;
+    if(widthaxes & 1){
+      Int_t binx = hist->GetXaxis()->FindBin(labelX);
+      if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) weight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+    }
+    if(widthaxes & 2){
+      Int_t biny = hist->GetYaxis()->FindBin(labelY);
+      if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) weight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+    }
   }
   hist->Fill(labelX, labelY, weight);
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
+	TH3 *hist = dynamic_cast<TH3 *>(FindFillTarget(name, "THistManager::FillTH3"));
 	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	UInt_t widthaxes = DecodeWidthAxes(opt, 3);
+	if(widthaxes){
+	  weight = 1.;
+	  if(widthaxes & 1) weight *= InverseBinWidth(hist->GetXaxis(), x);
+	  if(widthaxes & 2) weight *= InverseBinWidth(hist->GetYaxis(), y);
+	  if(widthaxes & 4) weight *= InverseBinWidth(hist->GetZaxis(), z);
 	}
 	hist->Fill(x, y, z, weight);
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	FillTH3(name, point[0], point[1], point[2], weight, opt);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
+	THnSparseD *hist = dynamic_cast<THnSparseD *>(FindFillTarget(name, "THistManager::FillTHnSparse"));
 	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
 		return;
 	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
-	  std::stringstream weighthandler;
-	  weighthandler << "w" << iaxis;
-	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
+	UInt_t widthaxes = DecodeWidthAxes(opt, hist->GetNdimensions(), true);
+	if(widthaxes){
+	  weight = 1.;
+	  for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
+	    if(widthaxes & (1u << iaxis)) weight *= InverseBinWidth(hist->GetAxis(iaxis), x[iaxis]);
 	  }
 	}
-
 	hist->Fill(x, weight);
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
+  TProfile *hist = dynamic_cast<TProfile *>(FindFillTarget(name, "THistManager::FillTProfile"));
   if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", histname(name).Data(), basename(name).Data());
+  hist->Fill(x, y, weight);
+}
+
+void THistManager::Fill(const THistHandle<TH1> &hist, double x, double weight){
+  if(hist.GetWidthAxes()){
+    // same convention as FillTH1 with option "w"
+    Int_t bin = hist->GetXaxis()->FindBin(x);
+    if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+      weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+  }
+  hist->Fill(x, weight);
+}
+
+void THistManager::Fill(const THistHandle<TH2> &hist, double x, double y, double weight){
+  if(hist.GetWidthAxes()){
+    // same convention as FillTH2 with option "wx" and/or "wy"
+    weight = 1.;
+    if(hist.HasWidthAxis(0)) weight *= InverseBinWidth(hist->GetXaxis(), x);
+    if(hist.HasWidthAxis(1)) weight *= InverseBinWidth(hist->GetYaxis(), y);
+  }
+  hist->Fill(x, y, weight);
+}
+
+void THistManager::Fill(const THistHandle<TH3> &hist, double x, double y, double z, double weight){
+  if(hist.GetWidthAxes()){
+    weight = 1.;
+    if(hist.HasWidthAxis(0)) weight *= InverseBinWidth(hist->GetXaxis(), x);
+    if(hist.HasWidthAxis(1)) weight *= InverseBinWidth(hist->GetYaxis(), y);
+    if(hist.HasWidthAxis(2)) weight *= InverseBinWidth(hist->GetZaxis(), z);
+  }
+  hist->Fill(x, y, z, weight);
+}
+
+void THistManager::Fill(const THistHandle<THnSparse> &hist, const double *x, double weight){
+  if(hist.GetWidthAxes()){
+    weight = 1.;
+    for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
+      if(hist.HasWidthAxis(iaxis)) weight *= InverseBinWidth(hist->GetAxis(iaxis), x[iaxis]);
+    }
+  }
+  hist->Fill(x, weight);
+}
+
+void THistManager::Fill(const THistHandle<TProfile> &hist, double x, double y, double weight){
   hist->Fill(x, y, weight);
 }
 
+THistHandle<TH1> THistManager::GetTH1(const char *name, Option_t *opt) const {
+  return THistHandle<TH1>(dynamic_cast<TH1 *>(FindObject(name)), DecodeWidthAxes(opt, 1));
+}
+
+THistHandle<TH2> THistManager::GetTH2(const char *name, Option_t *opt) const {
+  return THistHandle<TH2>(dynamic_cast<TH2 *>(FindObject(name)), DecodeWidthAxes(opt, 2));
+}
+
+THistHandle<TH3> THistManager::GetTH3(const char *name, Option_t *opt) const {
+  return THistHandle<TH3>(dynamic_cast<TH3 *>(FindObject(name)), DecodeWidthAxes(opt, 3));
+}
+
+THistHandle<THnSparse> THistManager::GetTHnSparse(const char *name, Option_t *opt) const {
+  THnSparse *hist = dynamic_cast<THnSparse *>(FindObject(name));
+  return THistHandle<THnSparse>(hist, hist ? DecodeWidthAxes(opt, hist->GetNdimensions(), true) : 0);
+}
+
+THistHandle<TProfile> THistManager::GetTProfile(const char *name) const {
+  return THistHandle<TProfile>(dynamic_cast<TProfile *>(FindObject(name)));
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -639,6 +609,47 @@ TObject* THistManager::FindObject(const TObject* obj) const {
 	return parent->FindObject(hname);
 }
 
+TObject *THistManager::FindFillTarget(const char *name, const char *method) {
+  // The cache is keyed on the address of the name. Names built with Form or
+  // TString::Data() can reuse the same address for a different name, therefore
+  // an entry is only accepted if also the content matches.
+  auto cached = fFillCache.find(name);
+  if(cached != fFillCache.end() && cached->second.first == name) return cached->second.second;
+  TString dirname(basename(name));
+  THashList *parent(FindGroup(dirname));
+  if(!parent){
+    Fatal(method, "Parent group %s does not exist", dirname.Data());
+    return nullptr;
+  }
+  TObject *target = parent->FindObject(histname(name));
+  if(target){
+    if(fFillCache.size() >= kMaxFillCache) fFillCache.clear();
+    fFillCache[name] = std::make_pair(std::string(name), target);
+  }
+  return target;
+}
+
+UInt_t THistManager::DecodeWidthAxes(Option_t *opt, int ndim, bool numbered) {
+  if(!opt || !strlen(opt)) return 0;
+  TString optionstring(opt);
+  optionstring.ToLower();
+  if(!optionstring.Contains("w")) return 0;
+  if(ndim == 1 && !numbered) return 1;
+  const char *axisnames[3] = {"wx", "wy", "wz"};
+  UInt_t widthaxes = 0;
+  for(int iaxis = 0; iaxis < ndim && iaxis < 32; iaxis++){
+    if(numbered ? optionstring.Contains(Form("w%d", iaxis)) : (iaxis < 3 && optionstring.Contains(axisnames[iaxis])))
+      widthaxes |= 1u << iaxis;
+  }
+  return widthaxes;
+}
+
+double THistManager::InverseBinWidth(const TAxis *axis, double x) {
+  Int_t bin = axis->FindBin(x);
+  if(bin == 0 || bin == axis->GetNbins()) return 1.;
+  return 1./axis->GetBinWidth(bin);
+}
+
 THashList *THistManager::FindGroup(const char *dirname) const {
 	if(!strlen(dirname) || !strcmp(dirname, "/")) return fHistos;
 	// recursive find - avoids tokenizing filename
@@ -1030,6 +1041,81 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    THistHandle<TH1> handle1 = testmgr.CreateTH1("Group1/Test", "Test handle group 1", 1, 0., 1.),
+                     handle2 = testmgr.CreateTH1("Group2/Test", "Test handle group 2", 1, 0., 1.);
+    THistHandle<TH2> handle2D = testmgr.CreateTH2("Test2D", "Test handle bin width", 2, 0., 1., 1, 0., 1., "wx");
+
+    for(int i = 0; i < 100; i++){
+      testmgr.Fill(handle1, 0.5);
+      testmgr.Fill(handle2, 0.5);
+      testmgr.Fill(handle2D, 0.25, 0.5);
+      for(int igroup = 1; igroup <= 2; igroup++){
+        testmgr.FillTH1(Form("Group%d/Test", igroup), 0.5);
+      }
+      testmgr.FillTH2("Test2D", 0.25, 0.5, 1., "wx");
+    }
+
+    // Evaluate test
+    bool success(true);
+    TH1 *hists[2] = {handle1, handle2};
+    for(int igroup = 0; igroup < 2; igroup++){
+      if(TMath::Abs(hists[igroup]->GetBinContent(1) - 200) > DBL_EPSILON){
+        std::cout << "Group" << igroup+1 << "/Test: Value mismatch: expected 200, found " << hists[igroup]->GetBinContent(1) << std::endl;
+        success = false;
+      }
+    }
+    if(TMath::Abs(handle2D->GetBinContent(1, 1) - 400) > 1e-9){
+      std::cout << "Test2D: Value mismatch: expected 400, found " << handle2D->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+
+    // Fills by name and via handle have to agree, for the bin width correction and for plain weights
+    const char *histtypes[4] = {"TH2", "TH3", "TH3Weight", "THnSparse"};
+    const double expected[4] = {200., 400., 300., 200.};
+    const int nbinsSparse[2] = {2, 2};
+    const double minSparse[2] = {0., 0.}, maxSparse[2] = {1., 1.};
+    THistHandle<TH2> handleTH2[2];
+    THistHandle<TH3> handleTH3[2], handleTH3Weight[2];
+    THistHandle<THnSparse> handleSparse[2];
+    const char *fillmodes[2] = {"ByName", "ByHandle"};
+    for(int imode = 0; imode < 2; imode++){
+      handleTH2[imode] = testmgr.CreateTH2(Form("TH2%s", fillmodes[imode]), "Test TH2", 2, 0., 1., 2, 0., 1., "wy");
+      handleTH3[imode] = testmgr.CreateTH3(Form("TH3%s", fillmodes[imode]), "Test TH3", 2, 0., 1., 2, 0., 1., 2, 0., 1., "wxwz");
+      handleTH3Weight[imode] = testmgr.CreateTH3(Form("TH3Weight%s", fillmodes[imode]), "Test TH3 weight", 2, 0., 1., 2, 0., 1., 2, 0., 1.);
+      handleSparse[imode] = testmgr.CreateTHnSparse(Form("THnSparse%s", fillmodes[imode]), "Test THnSparse", 2, nbinsSparse, minSparse, maxSparse, "w1");
+    }
+    double point[3] = {0.25, 0.25, 0.25};
+    for(int i = 0; i < 100; i++){
+      testmgr.FillTH2("TH2ByName", point, 3., "wy");
+      testmgr.FillTH3("TH3ByName", point, 3., "wxwz");
+      testmgr.FillTH3("TH3WeightByName", point[0], point[1], point[2], 3.);
+      testmgr.FillTHnSparse("THnSparseByName", point, 3., "w1");
+      testmgr.Fill(handleTH2[1], point[0], point[1], 3.);
+      testmgr.Fill(handleTH3[1], point[0], point[1], point[2], 3.);
+      testmgr.Fill(handleTH3Weight[1], point[0], point[1], point[2], 3.);
+      testmgr.Fill(handleSparse[1], point, 3.);
+    }
+    for(int imode = 0; imode < 2; imode++){
+      Long64_t sparsebin = handleSparse[imode]->GetBin(point, kFALSE);
+      double content[4] = {
+        handleTH2[imode]->GetBinContent(1, 1),
+        handleTH3[imode]->GetBinContent(1, 1, 1),
+        handleTH3Weight[imode]->GetBinContent(1, 1, 1),
+        sparsebin < 0 ? 0. : handleSparse[imode]->GetBinContent(sparsebin)
+      };
+      for(int itype = 0; itype < 4; itype++){
+        if(TMath::Abs(content[itype] - expected[itype]) > 1e-9){
+          std::cout << histtypes[itype] << fillmodes[imode] << ": Value mismatch: expected " << expected[itype] << ", found " << content[itype] << std::endl;
+          success = false;
+        }
+      }
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1136,10 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1162,9 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
 }
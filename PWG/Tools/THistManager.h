@@ -7,6 +7,9 @@
 #include <TIterator.h>
 #include <TNamed.h>
 #include <iterator>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 class TArrayD;
 class TAxis;
@@ -23,6 +26,67 @@ class TProfile;
  * @brief Histogram manager and components needed to make it work.
  */
 
+/**
+ * @class THistHandle
+ * @brief Typed reference to a histogram inside the THistManager
+ * @ingroup Histmanager
+ *
+ * Handles are returned by the Create methods of the THistManager and
+ * can be filled with THistManager::Fill without any lookup of the
+ * histogram by name. In addition the handle carries the axes for which
+ * the entries are corrected for the bin width, decoded once from the
+ * option string. The handle converts to the plain histogram pointer,
+ * hence it can be used wherever the pointer was used before. The
+ * histogram stays owned by the histogram manager.
+ */
+template<typename HIST>
+class THistHandle {
+public:
+  /**
+   * @brief Dummy constructor, handle not pointing to any histogram
+   */
+  THistHandle(): fHist(nullptr), fWidthAxes(0) {}
+
+  /**
+   * @brief Constructor
+   * @param[in] hist Histogram the handle points to
+   * @param[in] widthaxes Bit mask of the axes for which the bin width is corrected
+   */
+  explicit THistHandle(HIST *hist, UInt_t widthaxes = 0): fHist(hist), fWidthAxes(widthaxes) {}
+
+  /**
+   * @brief Destructor
+   */
+  ~THistHandle() {}
+
+  operator HIST *() const { return fHist; }
+  HIST *operator->() const { return fHist; }
+  HIST *Get() const { return fHist; }
+
+  /**
+   * @brief Get the axes for which the entries are corrected for the bin width
+   * @return Bit mask, bit i set for axis i
+   */
+  UInt_t GetWidthAxes() const { return fWidthAxes; }
+
+  /**
+   * @brief Check whether entries are corrected for the bin width in a given axis
+   * @param[in] iaxis Axis (0 = x, 1 = y, 2 = z)
+   * @return True if the bin width is corrected for in this axis
+   */
+  bool HasWidthAxis(int iaxis) const { return iaxis < 32 && (fWidthAxes & (1u << iaxis)); }
+
+  /**
+   * @brief Set the axes for which the entries are corrected for the bin width
+   * @param[in] widthaxes Bit mask, bit i set for axis i
+   */
+  void SetWidthAxes(UInt_t widthaxes) { fWidthAxes = widthaxes; }
+
+private:
+  HIST                        *fHist;               ///< Histogram (not owned)
+  UInt_t                      fWidthAxes;           ///< Axes for which the entries are corrected for the bin width
+};
+
 /**
  * @class THistManager
  * @brief Container class for histograms
@@ -82,7 +146,7 @@ class TProfile;
  * with random values of an exponential distribution.
  *
  * ~~~{.cxx}
- * for(auto en : ROOT::TSeqI(0, 10000) {
+ * for(auto en : ROOT::TSeqI(0, 10000)) {
  *   double pt = gRandom->Exp(-1);
  *   mgr.FillTH1("hPt", pt);
  * }
@@ -95,6 +159,25 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * # Filling via handles
+ *
+ * The lookup of a histogram by its name is cached inside the manager, keyed on
+ * the address of the name, so string based fills with constant names only pay
+ * for the full lookup once. For hot loops the Create methods return a typed
+ * handle (@ref THistHandle) which can be stored and filled directly. Options for the
+ * bin width correction are given at creation time (*W* for TH1, *WX*, *WY* and *WZ*
+ * for TH2 and TH3, *W0*, *W1*, ... for THnSparse) and applied at each fill.
+ *
+ * ~~~{.cxx}
+ * THistHandle<TH1> hpt = mgr.CreateTH1("hPt", "pt-distribution", TLinearBinning(100, 0., 100.), "w");
+ * for(auto en : ROOT::TSeqI(0, 10000)) {
+ *   mgr.Fill(hpt, gRandom->Exp(-1));
+ * }
+ * ~~~
+ *
+ * Histograms which are removed from the manager via the list of histograms
+ * must not be filled by name any more afterwards.
  */
 class THistManager : public TNamed {
 public:
@@ -275,9 +358,9 @@ public:
 	 * @param nbins number of bins
 	 * @param xmin min. value of the range
 	 * @param xmax max. value of the range
-	 * @param opt Additonal options (s for sumw2)
+	 * @param opt Additonal options (s for sumw2, w for bin width correction in handle fills)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt = "");
+	THistHandle<TH1> CreateTH1(const char *name, const char *title, int nbins, double xmin, double xmax, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH1 within the container.
@@ -288,9 +371,9 @@ public:
 	 * @param[in] title Title of the histogram
 	 * @param[in] nbins number of bins
 	 * @param[in] xbins array of bin limits
-	 * @param[in] opt Additonal options (s for sumw2)
+	 * @param[in] opt Additonal options (s for sumw2, w for bin width correction in handle fills)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt = "");
+	THistHandle<TH1> CreateTH1(const char *name, const char *title, int nbins, const double *xbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH1 within the container.
@@ -300,9 +383,9 @@ public:
 	 * @param[in] name Name of the histogram
 	 * @param[in] title Title of the histogram
 	 * @param[in] xbins array of bin limits (contains also number of bins)
-	 * @param[in] opt Additonal options (s for sumw2)
+	 * @param[in] opt Additonal options (s for sumw2, w for bin width correction in handle fills)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+	THistHandle<TH1> CreateTH1(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH1 within the container.
@@ -312,9 +395,9 @@ public:
 	 * @param[in] name Name of the histogram
 	 * @param[in] title Title of the histogram
 	 * @param[in] xbins User Binning
-	 * @param[in] opt Additonal options (s for sumw2)
+	 * @param[in] opt Additonal options (s for sumw2, w for bin width correction in handle fills)
 	 */
-	TH1* CreateTH1(const char *name, const char *title, const TBinning &binning, Option_t *opt = "");
+	THistHandle<TH1> CreateTH1(const char *name, const char *title, const TBinning &binning, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -330,7 +413,7 @@ public:
 	 * @param[in] ymin min. value of the range in y-direction
 	 * @param[in] ymax max. value of the range in y-direction
 	 */
-	TH2* CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt = "");
+	THistHandle<TH2> CreateTH2(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -346,7 +429,7 @@ public:
 	 * @param[in] ymin min. value of the range in y-direction
 	 * @param[in] ymax max. value of the range in y-direction
 	 */
-	TH2* CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt = "");
+	THistHandle<TH2> CreateTH2(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -358,7 +441,7 @@ public:
 	 * @param[in] xbins array of bin limits in x-direction (contains also the number of bins)
 	 * @param[in] ybins array of bin limits in y-direction (contains also the number of bins)
 	 */
-	TH2* CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt = "");
+	THistHandle<TH2> CreateTH2(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -370,7 +453,7 @@ public:
 	 * @param[in] User binning in x-direction
 	 * @param[in] User binning in y-direction
 	 */
-	TH2* CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt = "");
+	THistHandle<TH2> CreateTH2(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH2 within the container.
@@ -386,7 +469,7 @@ public:
 	 * @param[in] ymin min. value of the range in y-direction
 	 * @param[in] ymax max. value of the range in y-direction
 	 */
-	TH3* CreateTH3(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt = "");
+	THistHandle<TH3> CreateTH3(const char *name, const char *title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax, int nbinsz, double zmin, double zmax, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH3 within the container.
@@ -402,7 +485,7 @@ public:
 	 * @param[in] nbinsz number of bins in z-direction
 	 * @param[in] zbins array of bin limits in z-direction
 	 */
-	TH3* CreateTH3(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, int nbinsz, const double *zbins, Option_t *opt = "");
+	THistHandle<TH3> CreateTH3(const char *name, const char *title, int nbinsx, const double *xbins, int nbinsy, const double *ybins, int nbinsz, const double *zbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH3 within the container.
@@ -415,7 +498,7 @@ public:
 	 * @param[in] ybins array of bin limits in y-direction (contains also the number of bins)
 	 * @param[in] zbins array of bin limits in z-direction (contains also the number of bins)
 	 */
-	TH3* CreateTH3(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, const TArrayD &zbins, Option_t *opt = "");
+	THistHandle<TH3> CreateTH3(const char *name, const char *title, const TArrayD &xbins, const TArrayD &ybins, const TArrayD &zbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new TH3 within the container.
@@ -428,7 +511,7 @@ public:
 	 * @param[in] User binning in y-direction
 	 * @param[in] User binning in z-direction
 	 */
-	TH3* CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt = "");
+	THistHandle<TH3> CreateTH3(const char *name, const char *title, const TBinning &xbins, const TBinning &ybins, const TBinning &zbins, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new THnSparse within the container.
@@ -442,7 +525,7 @@ public:
 	 * @param[in] min min. value of the range for each dimension
 	 * @param[in] max max. value of the range for each dimension
 	 */
-	THnSparse* CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt = "");
+	THistHandle<THnSparse> CreateTHnSparse(const char *name, const char *title, int ndim, const int *nbins, const double *min, const double *max, Option_t *opt = "");
 
 	/**
 	 * @brief Create a new THnSparse within the container.
@@ -454,7 +537,7 @@ public:
 	 * @param[in] ndim Number of dimensions
 	 * @param[in] axes Array of pointers to TAxis for containing the axis definition for each dimension
 	 */
-	THnSparse* CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt = "");
+	THistHandle<THnSparse> CreateTHnSparse(const char *name, const char *title, int ndim, const TAxis **axes, Option_t *opt = "");
 
   /**
    * @brief Create a new THnSparse within the container.
@@ -466,7 +549,7 @@ public:
    * @param[in] ndim Number of dimensions
    * @param[in] axes Array of pointers to TAxis for containing the axis definition for each dimension
    */
-  THnSparse* CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt = "");
+  THistHandle<THnSparse> CreateTHnSparse(const char *name, const char *title, int ndim, const TBinning **axes, Option_t *opt = "");
 
 
 	/**
@@ -481,7 +564,7 @@ public:
 	 * @param[in] xmax max. value in x-direction
 	 * @param[in] opt Further options
 	 */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
+  THistHandle<TProfile> CreateTProfile(const char *name, const char *title, int nbinsX, double xmin, double xmax, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -494,7 +577,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
+  THistHandle<TProfile> CreateTProfile(const char *name, const char *title, int nbinsX, const double *xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -506,7 +589,7 @@ public:
    * @param[in] xbins binning in x-direction
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
+  THistHandle<TProfile> CreateTProfile(const char *name, const char *title, const TArrayD &xbins, Option_t *opt = "");
 
   /**
    * @brief Create a new TProfile within the container.
@@ -518,7 +601,7 @@ public:
    * @param[in] xbins User binning
    * @param[in] opt Further options
    */
-  void CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
+  THistHandle<TProfile> CreateTProfile(const char *name, const char *title, const TBinning &xbins, Option_t *opt = "");
 
   /**
    * @brief Set a new group into the container into the parent group
@@ -634,6 +717,102 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Fill a 1D histogram via its handle.
+   *
+   * No lookup by name is done. If the handle was created with option
+   * "w" the entry is weighted with the inverse bin width, as in FillTH1.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const THistHandle<TH1> &hist, double x, double weight = 1.);
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   *
+   * No lookup by name is done. If the handle was created with option
+   * "wx" and/or "wy" the entry is weighted with the inverse bin width in
+   * the requested directions instead of the weight, as in FillTH2.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const THistHandle<TH2> &hist, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   *
+   * No lookup by name is done. Bin width correction as for the 2D case,
+   * with "wz" for the z-direction.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const THistHandle<TH3> &hist, double x, double y, double z, double weight = 1.);
+
+  /**
+   * @brief Fill a nD histogram via its handle.
+   *
+   * No lookup by name is done. Bin width correction as for the 2D case,
+   * with "w<i>" for axis i.
+   * @param[in] hist Handle of the histogram
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const THistHandle<THnSparse> &hist, const double *x, double weight = 1.);
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   * @param[in] hist Handle of the profile histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void Fill(const THistHandle<TProfile> &hist, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Get handle of a 1D histogram already in the container
+   * @param[in] name Name of the histogram (including parent groups)
+   * @param[in] opt Bin width correction (w)
+   * @return Handle of the histogram (not pointing to any histogram if not found)
+   */
+  THistHandle<TH1> GetTH1(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Get handle of a 2D histogram already in the container
+   * @param[in] name Name of the histogram (including parent groups)
+   * @param[in] opt Bin width correction (wx, wy)
+   * @return Handle of the histogram (not pointing to any histogram if not found)
+   */
+  THistHandle<TH2> GetTH2(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Get handle of a 3D histogram already in the container
+   * @param[in] name Name of the histogram (including parent groups)
+   * @param[in] opt Bin width correction (wx, wy, wz)
+   * @return Handle of the histogram (not pointing to any histogram if not found)
+   */
+  THistHandle<TH3> GetTH3(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Get handle of a nD histogram already in the container
+   * @param[in] name Name of the histogram (including parent groups)
+   * @param[in] opt Bin width correction (w0, w1, ...)
+   * @return Handle of the histogram (not pointing to any histogram if not found)
+   */
+  THistHandle<THnSparse> GetTHnSparse(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Get handle of a profile histogram already in the container
+   * @param[in] name Name of the profile histogram (including parent groups)
+   * @return Handle of the histogram (not pointing to any histogram if not found)
+   */
+  THistHandle<TProfile> GetTProfile(const char *name) const;
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -719,11 +898,42 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Find the histogram to be filled by a string based fill.
+	 *
+	 * The result is cached per address of the name. Cache entries are
+	 * only used if the content of the name matches as well.
+	 * @param[in] name Name of the histogram (including parent groups)
+	 * @param[in] method Name of the calling method (for error messages)
+	 * @return The histogram (NULL if not found in the parent group)
+	 */
+	TObject *FindFillTarget(const char *name, const char *method);
+
+	/**
+	 * @brief Decode the axes with bin width correction from an option string.
+	 * @param[in] opt Option string
+	 * @param[in] ndim Number of dimensions of the histogram
+	 * @param[in] numbered If true axes are numbered (w0, w1, ...), otherwise wx, wy, wz (w for 1D)
+	 * @return Bit mask, bit i set for axis i
+	 */
+	static UInt_t DecodeWidthAxes(Option_t *opt, int ndim, bool numbered = false);
+
+	/**
+	 * @brief Inverse bin width at a given position
+	 * @param[in] axis Axis
+	 * @param[in] x Position
+	 * @return 1/bin width, 1 for the underflow bin and the last bin
+	 */
+	static double InverseBinWidth(const TAxis *axis, double x);
+
+	enum { kMaxFillCache = 1024 };       ///< Max. number of cached names before the cache is reset
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	std::unordered_map<const char *, std::pair<std::string, TObject *> > fFillCache; //!<! Histograms found by string based fills, per address of the name
 
   /// \cond CLASSIMP
-	ClassDef(THistManager, 1);  // Container for histograms
+	ClassDef(THistManager, 2);  // Container for histograms
   /// \endcond
 };
 
@@ -845,6 +1055,26 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether filling via handles and the cached name lookup fill the correct histograms
+   * Relies on: TestBuildSimpleHistograms, TestBuildGroupedHistograms
+   *
+   * Creating 2 TH1 in 2 groups and 1 TH2 with bin width correction in x (bins of width 0.5)
+   * - Fill the TH1 100 times via handle and 100 times by name, where the name
+   *   is built with Form, such that different names can share the same address
+   * - Fill the TH2 100 times via handle and 100 times by name with option "wx" in bin (1,1)
+   * - Fill pairs of TH2 ("wy"), TH3 ("wxwz", no option) and THnSparse ("w1") with bins of width 0.5
+   *   100 times with weight 3, one of each pair by name and the other via handle
+   *
+   * Test passed:
+   * - Both TH1 have in bin 1 the bin content 200
+   * - The TH2 has in bin (1,1) the bin content 400
+   * - Histograms filled by name and via handle have the same content: 200 (TH2),
+   *   400 (TH3 with "wxwz"), 300 (TH3 without option) and 200 (THnSparse)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
 };
 
 /**
@@ -882,5 +1112,12 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandles();
+
 }
 #endif
@@ -25,6 +25,7 @@
 #include "AliUEHistograms.h"
 
 #include "AliCFContainer.h"
+#include "AliTHn.h"
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
@@ -35,6 +36,9 @@
 #include "TH1F.h"
 #include "TH3F.h"
 #include "TMath.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
 #include "TLorentzVector.h"
 
 ClassImp(AliUEHistograms)
@@ -686,6 +690,38 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
     }
     
+    // copy the associated particles into flat arrays (structure of arrays) for the pair loop below
+    TArrayD assocPtArr(jMax);
+    TArrayD assocPhiArr(jMax);
+    TArrayI assocChargeArr(jMax);
+    TArrayC assocResonanceArr(jMax);
+    for (Int_t j=0; j<jMax; j++)
+    {
+      AliVParticle* particle = (AliVParticle*) input->UncheckedAt(j);
+      assocPtArr.GetArray()[j] = particle->Pt();
+      assocPhiArr.GetArray()[j] = particle->Phi();
+      assocChargeArr.GetArray()[j] = particle->Charge();
+      assocResonanceArr.GetArray()[j] = (fRejectResonanceDaughters > 0 && particle->TestBit(kResonanceDaughterFlag));
+    }
+    const Double_t* assocPt = assocPtArr.GetArray();
+    const Double_t* assocPhi = assocPhiArr.GetArray();
+    const Int_t* assocCharge = assocChargeArr.GetArray();
+    const Char_t* assocResonance = assocResonanceArr.GetArray();
+    const Float_t* assocEta = eta.GetArray();
+
+    // candidates of one trigger particle and the variables of its accepted pairs, filled in one go
+    TArrayI candidatesArr(jMax);
+    TArrayD pairVarsArr(6 * jMax);
+    TArrayD pairWeightsArr(jMax);
+    TArrayI pairStepsArr(jMax);
+    for (Int_t j=0; j<jMax; j++)
+      pairStepsArr.GetArray()[j] = step;
+    Int_t* candidates = candidatesArr.GetArray();
+    Double_t* pairVars = pairVarsArr.GetArray();
+    Double_t* pairWeights = pairWeightsArr.GetArray();
+    AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+    AliTHnBase* trackHistTHn = dynamic_cast<AliTHnBase*> (trackHist);
+
     for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
       AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
@@ -713,16 +749,34 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  continue;
 	}
 	
+      const Double_t triggerPt = triggerParticle->Pt();
+      const Double_t triggerPhi = triggerParticle->Phi();
+      const Int_t triggerCharge = triggerParticle->Charge();
+
+      // first pass: cuts which only depend on the cached quantities, without branches
+      Int_t nCandidates = 0;
       for (Int_t j=0; j<jMax; j++)
       {
-        if (!mixed && i == j)
-          continue;
-      
-        AliVParticle* particle = 0;
-        if (!mixed)
-          particle = (AliVParticle*) particles->UncheckedAt(j);
-        else
-          particle = (AliVParticle*) mixed->UncheckedAt(j);
+        const Int_t chargeProduct = assocCharge[j] * triggerCharge;
+        Bool_t accept = (mixed != 0 || i != j);
+        accept &= !(fPtOrder && assocPt[j] >= triggerPt);
+        accept &= !(fAssociatedSelectCharge != 0 && assocCharge[j] * fAssociatedSelectCharge < 0);
+        accept &= !(fSelectCharge == 1 && chargeProduct > 0);   // skip like sign
+        accept &= !(fSelectCharge == 2 && chargeProduct < 0);   // skip unlike sign
+        accept &= !(fEtaOrdering && triggerEta < 0 && assocEta[j] < triggerEta);
+        accept &= !(fEtaOrdering && triggerEta > 0 && assocEta[j] > triggerEta);
+        accept &= !assocResonance[j];
+        
+        candidates[nCandidates] = j;
+        nCandidates += accept;
+      }
+
+      // second pass: the remaining cuts on the candidates, in the order of the original pair loop
+      Int_t nPairs = 0;
+      for (Int_t iCandidate=0; iCandidate<nCandidates; iCandidate++)
+      {
+        const Int_t j = candidates[iCandidate];
+        AliVParticle* particle = (AliVParticle*) input->UncheckedAt(j);
         
         // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
         if (fCheckEventNumberInCorrelation)
@@ -738,48 +792,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         else if (mixed && triggerParticle->IsEqual(particle))
           continue;
         
-        if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
-	    continue;
-	
-	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
-	    continue;
-
-        if (fSelectCharge > 0)
-        {
-          // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
-            continue;
-            
-          // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
-            continue;
-        }
-        
-	if (fEtaOrdering)
-	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
-	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
-	    continue;
-	}
-
-	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
-	  {
-// 	    Printf("Skipped j=%d", j);
-	    continue;
-	  }
+        const Int_t chargeProduct = assocCharge[j] * triggerCharge;
 
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && chargeProduct < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -789,15 +811,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && chargeProduct < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -807,16 +829,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && chargeProduct < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -825,7 +847,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, assocPt[j], assocEta[j], assocPhi[j], 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -839,15 +861,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  Float_t phi1 = triggerPhi;
+	  Float_t pt1 = triggerPt;
+	  Float_t charge1 = triggerCharge;
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
+	  Float_t phi2 = assocPhi[j];
+	  Float_t pt2 = assocPt[j];
+	  Float_t charge2 = assocCharge[j];
 	      
-	  Float_t deta = triggerEta - eta[j];
+	  Float_t deta = triggerEta - assocEta[j];
 	      
 	  // optimization
 	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
@@ -888,12 +910,12 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	}
         
-        Double_t vars[6];
-        vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        Double_t* vars = pairVars + 6 * nPairs;
+        vars[0] = triggerEta - assocEta[j];
+        vars[1] = assocPt[j];
+        vars[2] = triggerPt;
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
+        vars[4] = triggerPhi - assocPhi[j];
         if (vars[4] > 1.5 * TMath::Pi()) 
           vars[4] -= TMath::TwoPi();
         if (vars[4] < -0.5 * TMath::Pi())
@@ -901,7 +923,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = assocPt[j];
 	
 	Double_t useWeight = weight;
 	if (applyEfficiency)
@@ -910,7 +932,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  {
 	    Int_t effVars[4];
 	    // associated particle
-	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
+	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(assocEta[j]);
 	    effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(vars[1]); //pt
 	    effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(vars[3]); //centrality
 	    effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(vars[5]); //zVtx
@@ -938,11 +960,17 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  useWeight /= triggerWeighting->GetBinContent(weightBin);
 	}
     
-        // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
+	pairWeights[nPairs++] = useWeight;
 
 // 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
       }
+
+      // fill all in toward region and do not use the other regions
+      if (trackHistTHn)
+        trackHistTHn->Fill(nPairs, pairVars, pairStepsArr.GetArray(), pairWeights);
+      else
+        for (Int_t iPair=0; iPair<nPairs; iPair++)
+          trackHist->Fill(pairVars + 6 * iPair, step, pairWeights[iPair]);
  
       if (firstTime)
       {
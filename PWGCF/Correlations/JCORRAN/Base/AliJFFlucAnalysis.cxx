@@ -419,9 +419,15 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 	TComplex QnB_star[kNH];
 
 	//--------------- Calculate Qn--------------------
+	// all Q-vectors of the event (SP, SP per pt bin, QC) in one track loop
+	CalculateQvectorTable( Eta_config );
 	for(int ih=0; ih<kNH; ih++){
-		QnA[ih] = CalculateQnSP( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], ih);
-		QnB[ih] = CalculateQnSP( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], ih);
+		QnA[ih] = QvectorSP[ih][kSubA];
+		QnB[ih] = QvectorSP[ih][kSubB];
+		if( ih !=0 ){ // Use Qn[0] as total number of tracks(*eff)
+			QnA[ih] /= QvectorSP[0][kSubA].Re();
+			QnB[ih] /= QvectorSP[0][kSubB].Re();
+		}
 		QnB_star[ih] = TComplex::Conjugate ( QnB[ih] ) ;
 	}
 	NSubTracks[kSubA] = QnA[0].Re(); // this is number of tracks in Sub A
@@ -519,8 +525,6 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 	fh_correlator[17][fCBin]->Fill( V8V2starV3star_2.Re() );
 	fh_correlator[18][fCBin]->Fill( V8V2star_4.Re() );
 
-	CalculateQvectorsQC();
-
 	//cumulants (no mixed harmonics)
 	TComplex four[kNH];
 	TComplex two[kNH];
@@ -574,7 +578,6 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 
 	if(IsSCptdep == kTRUE){
 		const int SCNH = 9; // 0, 1, 2(v2), 3(v3), 4(v4), 5(v5)
-		Double_t ptbin_borders[N_ptbins+1] = {0.2, 0.4, 0.6, 0.8, 1.0, 1.25, 1.5, 2.0, 5.0};
 		//init
 		TComplex QnA_pt[SCNH][N_ptbins];
 		TComplex QnB_pt[SCNH][N_ptbins];
@@ -587,16 +590,20 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 			}
 		}
 
-		// calculate Qn for each pt bins
+		// Qn for each pt bins, normalised by the number of tracks(*eff) in the bin
+		for(int ipt=0; ipt<N_ptbins; ipt++){
+			NSubTracks_pt[Eta_config[kSubA][kMin] > 0 ? 1 : 0][ipt] = QvectorSPpt[0][kSubA][ipt].Re();
+			NSubTracks_pt[Eta_config[kSubB][kMin] > 0 ? 1 : 0][ipt] = QvectorSPpt[0][kSubB][ipt].Re();
+		}
 		for(int ih=2; ih<SCNH; ih++){
 			for(int ipt=0; ipt<N_ptbins; ipt++){
-				Double_t pt_bin_min = ptbin_borders[ipt];
-				Double_t pt_bin_max = ptbin_borders[ipt+1];
-				Double_t QAReal=Get_Qn_Real_pt( Eta_config[kSubA][0], Eta_config[kSubA][1], ih, ipt, pt_bin_min, pt_bin_max);
-				Double_t QAImag=Get_Qn_Img_pt(  Eta_config[kSubA][0], Eta_config[kSubA][1], ih, ipt, pt_bin_min, pt_bin_max);
+				Double_t SubA_Ntrk = QvectorSPpt[0][kSubA][ipt].Re();
+				Double_t SubB_Ntrk = QvectorSPpt[0][kSubB][ipt].Re();
+				Double_t QAReal = QvectorSPpt[ih][kSubA][ipt].Re() / SubA_Ntrk;
+				Double_t QAImag = QvectorSPpt[ih][kSubA][ipt].Im() / SubA_Ntrk;
 
-				Double_t QBReal=Get_Qn_Real_pt( Eta_config[kSubB][0], Eta_config[kSubB][1], ih, ipt, pt_bin_min, pt_bin_max);
-				Double_t QBImag=Get_Qn_Img_pt(  Eta_config[kSubB][0], Eta_config[kSubB][1], ih, ipt, pt_bin_min, pt_bin_max);
+				Double_t QBReal = QvectorSPpt[ih][kSubB][ipt].Re() / SubB_Ntrk;
+				Double_t QBImag = QvectorSPpt[ih][kSubB][ipt].Im() / SubB_Ntrk;
 
 				QnA_pt[ih][ipt]= TComplex(QAReal, QAImag);
 				QnB_pt[ih][ipt]= TComplex(QBReal, QBImag);
@@ -751,19 +758,67 @@ void AliJFFlucAnalysis::Fill_QA_plot( Double_t eta1, Double_t eta2 )
 }
 
 //________________________________________________________________________
-TComplex AliJFFlucAnalysis::CalculateQnSP( Double_t eta1, Double_t eta2, int harmonics)
+void AliJFFlucAnalysis::CalculateQvectorTable( const Double_t etaConfig[2][2] )
 {
-	int ih=harmonics;
-	TComplex Qn = TComplex(0,0);
-	Double_t Sub_Ntrk = 0; // number of Tracks * effCorr * phi modulation factor
+	// Single track loop filling all Q-vectors of the event:
+	//  QvectorSP[ih][isub]          : SP method, eta subevent isub (0 = A, 1 = B), min <= eta <= max
+	//  QvectorSPpt[ih][isub][ipt]   : SP method per pt bin (only if IsSCptdep), min < eta < max
+	//  QvectorQC[ih]                 : QC method, fQC_eta_cut_min <= eta <= fQC_eta_cut_max
+	//  QvectorQCeta10[ih][isub]      : QC method, |eta| > 0.4, isub = 0 (1) for eta < 0 (> 0)
+	// The SP vectors are weighted with 1/eff * phi modulation correction and not
+	// normalised, [0] holds the sum of weights. The weight, cos and sin of each track
+	// are calculated once. Tracks are summed up in the order of the input list.
+	// The QC method uses unit weights, hence all powers of the weights of the
+	// generic framework are the same and only Q(n,1) is stored.
+	const Double_t ptbin_borders[N_ptbins+1] = {0.2, 0.4, 0.6, 0.8, 1.0, 1.25, 1.5, 2.0, 5.0};
+	enum{kMin, kMax};
+
+	for(int ih=0; ih<kNH; ih++){
+		QvectorQC[ih] = TComplex(0, 0);
+		for(int isub=0; isub<2; isub++){
+			QvectorQCeta10[ih][isub] = TComplex(0, 0);
+			QvectorSP[ih][isub] = TComplex(0, 0);
+			for(int ipt=0; ipt<N_ptbins; ipt++)
+				QvectorSPpt[ih][isub][ipt] = TComplex(0, 0);
+		}
+	}
+
+	Double_t cosnphi[kNH];
+	Double_t sinnphi[kNH];
 	Long64_t ntracks = fInputList->GetEntriesFast();
-	for(Long64_t it=0; it< ntracks; it++){
+	for( Long64_t it=0; it<ntracks; it++){
 		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
 		Double_t pt = itrack->Pt();
 		Double_t eta = itrack->Eta();
 		Double_t phi = itrack->Phi();
-		if( eta < eta1 || eta > eta2)
-			continue; // eta cut
+
+		Bool_t inSP[2];
+		for(int isub=0; isub<2; isub++)
+			inSP[isub] = !( eta < etaConfig[isub][kMin] || eta > etaConfig[isub][kMax] );
+		Bool_t inQC = !( eta < fQC_eta_cut_min || eta > fQC_eta_cut_max );
+		if( !inSP[0] && !inSP[1] && !inQC )
+			continue;
+
+		for(int ih=0; ih<kNH; ih++){
+			cosnphi[ih] = TMath::Cos(ih*phi);
+			sinnphi[ih] = TMath::Sin(ih*phi);
+		}
+
+		if( inQC ){
+			for(int ih=0; ih<kNH; ih++){
+				TComplex q = TComplex( cosnphi[ih], sinnphi[ih] );
+				QvectorQC[ih] += q;
+				if( TMath::Abs(eta) > 0.4 ){  // this is for normalized SC ( denominator needs an eta gap )
+					int isub = 0;
+					if( eta > 0 )
+						isub = 1;
+					QvectorQCeta10[ih][isub] += q;
+				}
+			}
+		}
+
+		if( !inSP[0] && !inSP[1] )
+			continue;
 
 		Double_t phi_module_corr = 1;
 		int isub = -1;
@@ -775,15 +830,29 @@ TComplex AliJFFlucAnalysis::CalculateQnSP( Double_t eta1, Double_t eta2, int har
 			phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi ) )  );
 		}
 		Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent );
+		Double_t weight = 1./effCorr * phi_module_corr;
+
+		int ipt = -1;
+		if( IsSCptdep == kTRUE ){
+			for(int ib=0; ib<N_ptbins; ib++){
+				if( pt > ptbin_borders[ib] && pt < ptbin_borders[ib+1] ){
+					ipt = ib;
+					break;
+				}
+			}
+		}
 
-		Qn += TComplex( 1./effCorr * phi_module_corr * TMath::Cos(ih*phi), 1./effCorr * phi_module_corr * TMath::Sin(ih*phi) );
-		Sub_Ntrk += 1./effCorr * phi_module_corr ;
+		for(int is=0; is<2; is++){
+			if( !inSP[is] )
+				continue;
+			for(int ih=0; ih<kNH; ih++)
+				QvectorSP[ih][is] += TComplex( weight * cosnphi[ih], weight * sinnphi[ih] );
+			if( ipt < 0 || !( eta > etaConfig[is][kMin] && eta < etaConfig[is][kMax] ) )
+				continue;
+			for(int ih=0; ih<kNH; ih++)
+				QvectorSPpt[ih][is][ipt] += TComplex( weight * cosnphi[ih], weight * sinnphi[ih] );
+		}
 	}
-
-	if( ih !=0)
-		Qn /= Sub_Ntrk; // Use Qn[0] as total number of tracks(*eff)
-
-	return Qn;
 }
 ///________________________________________________________________________
 Double_t AliJFFlucAnalysis::Get_QC_Vn(Double_t QnA_real, Double_t QnA_img, Double_t QnB_real, Double_t QnB_img )
@@ -798,123 +867,6 @@ Double_t AliJFFlucAnalysis::Get_QC_Vn(Double_t QnA_real, Double_t QnA_img, Doubl
 	return QC_Vn;
 }
 //________________________________________________________________________
-Double_t AliJFFlucAnalysis::Get_Qn_Real_pt(Double_t eta1, Double_t eta2, int harmonics, int ptbin, Double_t pt_min, Double_t pt_max)
-{
-	if( eta1 > eta2) cout << "ERROR eta1 should be smaller than eta2!!!" << endl;
-	int nh = harmonics;
-	Double_t Qn_real = 0;
-	Double_t Sub_Ntrk =0;
-
-	Long64_t ntracks = fInputList->GetEntriesFast();
-	for( Long64_t it=0; it< ntracks; it++){
-		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-		Double_t eta = itrack->Eta();
-		Double_t pt = itrack->Pt();
-		if( pt > pt_min && pt < pt_max){
-			if( eta>eta1 &&  eta<eta2 ){
-				int isub = -1;
-				if( eta < 0 )
-					isub = 0;
-				if( eta > 0 )
-					isub = 1;
-				Double_t phi = itrack->Phi();
-				Double_t phi_module_corr =1;
-				if( IsPhiModule == kTRUE){
-					phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi )) );
-				}
-				Double_t pt = itrack->Pt();
-				Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent);
-				Qn_real += 1.0 / effCorr * phi_module_corr * TMath::Cos( nh * phi);
-				Sub_Ntrk = Sub_Ntrk + 1.0 / effCorr * phi_module_corr;
-			}
-		}
-	}
-	Qn_real /= Sub_Ntrk;
-	int iside = 0; // eta -
-	if (eta1 > 0 )
-		iside = 1; // eta +
-	NSubTracks_pt[iside][ptbin] = Sub_Ntrk; // it will be overwrite for each harmonics but should be same.
-
-	return Qn_real;
-}
-//________________________________________________________________________
-Double_t AliJFFlucAnalysis::Get_Qn_Img_pt(Double_t eta1, Double_t eta2, int harmonics, int ptbin, Double_t pt_min, Double_t pt_max)
-{
-	int nh = harmonics;
-	Double_t Qn_img = 0;
-	Double_t Sub_Ntrk =0;
-
-	Long64_t ntracks = fInputList->GetEntriesFast();
-	for( Long64_t it=0; it< ntracks; it++){
-		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-		Double_t eta = itrack->Eta();
-		Double_t pt = itrack->Pt();
-		if(pt>pt_min && pt<pt_max){
-			if( eta > eta1 && eta < eta2 ){
-				int isub = -1;
-				if( eta < 0 ) isub = 0;
-				if( eta > 0 ) isub = 1;
-				Double_t phi = itrack->Phi();
-				Double_t phi_module_corr =1;
-				if( IsPhiModule == kTRUE){
-					phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi )) );
-				}
-				Double_t pt = itrack->Pt();
-				Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent);
-				Qn_img += 1./ effCorr * phi_module_corr * TMath::Sin( nh * phi);
-				Sub_Ntrk = Sub_Ntrk + 1./ effCorr * phi_module_corr;
-			}
-		}
-	}
-	Qn_img /= Sub_Ntrk;
-	return Qn_img;
-}
-///________________________________________________________________________
-/* new Function for QC method
-   Please see Generic Framwork from Ante
-   use Standalone method  */
-//________________________________________________________________________
-void AliJFFlucAnalysis::CalculateQvectorsQC(){
-	// calcualte Q-vector for QC method ( no subgroup )
-	//init
-	for(int ih=0; ih<kNH; ih++){
-		QvectorQC[ih] = TComplex(0, 0);
-		for(int isub=0; isub<2; isub++){
-			QvectorQCeta10[ih][isub] = TComplex(0, 0);
-		}
-	} // for max harmonics
-	//Calculate Q-vector with particle loop
-	Long64_t ntracks = fInputList->GetEntriesFast(); // all tracks from Task input
-	for( Long64_t it=0; it<ntracks; it++){
-		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
-		Double_t phi = itrack->Phi();
-		Double_t eta = itrack->Eta();
-		// track Eta cut Note! pt cuts already applied in AliJFFlucTask.cxx
-		// Do we need arbitary Eta cut for QC method?
-		// fixed eta ranged -0.8 < eta < 0.8 for QC
-//				if( TMath::Abs(eta) > fEta_max || TMath::Abs(eta) < fEta_min ) continue; << this is SP cut
-//				if( TMath::Abs(eta) > 0.8 ) continue;  //   << this is old QC cut
-		// we need more configuration for to study eta dep of SC(m,n) with QC method.
-		// eta cut among all tracks (this is not same with SC(m,n) SP method (SP method needs symmetric eta range)//
-		if( eta < fQC_eta_cut_min || eta > fQC_eta_cut_max)
-			continue;
-		/////////////////////////////////////////////////
-
-		for(int ih=0; ih<kNH; ih++){
-			//for(int ik=0; ik<nKL; ik++){
-			TComplex q = TComplex( TMath::Cos(ih*phi), TMath::Sin(ih*phi) );
-			QvectorQC[ih] += q;
-			if( TMath::Abs(eta) > 0.4 ){  // this is for normalized SC ( denominator needs an eta gap )
-				int isub = 0;
-				if( eta > 0 )
-					isub = 1;
-				QvectorQCeta10[ih][isub] += q;
-			}
-			//}
-		}
-	} // track loop done.
-}
-//________________________________________________________________________
 TComplex AliJFFlucAnalysis::Q(int n, int p){
 	// Retrun QvectorQC
 	// Q{-n, p} = Q{n, p}*
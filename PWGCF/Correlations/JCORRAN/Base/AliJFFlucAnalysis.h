@@ -55,10 +55,8 @@ public:
 	
 	inline void DEBUG(int level, TString msg){if(level<fDebugLevel) std::cout<<level<<"\t"<<msg<<endl;}
 
-	TComplex CalculateQnSP( double eta1, double eta2, int harmonics);
+	void CalculateQvectorTable( const Double_t etaConfig[2][2] ); // etaConfig[isub][min/max]
 
-	double Get_Qn_Real_pt(double eta1, double eta2, int harmonics, int ipt, double pt_min, double pt_max);
-	double Get_Qn_Img_pt(double eta1, double eta2, int harmonics, int ipt, double pt_min, double pt_max);
 	double Get_QC_Vn( double QnA_real, double QnA_img, double QnB_real, double QnB_img);
 	void Fill_QA_plot(double eta1, double eta2 );
 
@@ -66,7 +64,6 @@ public:
 	AliJEfficiency* GetAliJEfficiency() { return fEfficiency; }
 
 	// new function for QC method //
-	void CalculateQvectorsQC();
 	TComplex Q(int n, int p);
 	TComplex Two( int n1, int n2);
 	TComplex Four( int n1, int n2, int n3, int n4);
@@ -152,6 +149,8 @@ private:
 	// addtinal variables for ptbins(Standard Candles only)
 	enum{kPt0, kPt1, kPt2, kPt3, kPt4, kPt5, kPt6, kPt7, N_ptbins};
 	double NSubTracks_pt[2][N_ptbins];
+	TComplex QvectorSP[kNH][2];//! // [ih][isub], weighted sum, [0] = sum of weights
+	TComplex QvectorSPpt[kNH][2][N_ptbins];//! // [ih][isub][ipt], same per pt bin
 	AliJBin fBin_Nptbins;//!
 	AliJTH1D fh_SC_ptdep_4corr;//! // for < vn^2 vm^2 >
 	AliJTH1D fh_SC_ptdep_2corr;//!  // for < vn^2 >
@@ -163,7 +162,7 @@ private:
 	//AliJTH1D fh_QvectorQCphi;//!
 	AliJTH1D fh_evt_SP_QC_ratio_2p;//! // check SP QC evt by evt ratio
 	AliJTH1D fh_evt_SP_QC_ratio_4p;//! // check SP QC evt by evt ratio
-	ClassDef(AliJFFlucAnalysis, 1); // example of analysis
+	ClassDef(AliJFFlucAnalysis, 2); // example of analysis
 };
 
 #endif
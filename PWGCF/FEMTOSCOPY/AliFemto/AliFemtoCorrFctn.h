@@ -12,6 +12,8 @@
 #include "AliFemtoPair.h"
 #include "AliFemtoPairCut.h"
 
+class AliFemtoModelManager;
+
 /// \class AliFemtoCorrFctn
 /// \brief The pure-virtual base class for correlation functions
 ///
@@ -50,8 +52,17 @@ public:
   virtual void EventEnd(const AliFemtoEvent* aEvent);
   virtual void Finish() = 0;
 
+  /// Window in pair kT and |qinv| outside of which AddRealPair() and
+  /// AddMixedPair() do nothing. Returns false if there is no such window
+  /// (the default), see AliFemtoPairCut::KinematicWindow.
+  virtual bool PairKinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const;
+
   virtual TList* GetOutputList() = 0;
 
+  /// Model manager providing the pair weights, NULL if there is none
+  /// (the default). The manager and its generators hold per-pair state.
+  virtual AliFemtoModelManager* ModelManager() const;
+
   virtual AliFemtoCorrFctn* Clone() { return 0;}
 
   AliFemtoAnalysis* HbtAnalysis(){return fyAnalysis;};
@@ -89,6 +100,16 @@ inline void AliFemtoCorrFctn::EventEnd(const AliFemtoEvent* /* event */)
 {  // no-op
 }
 
+inline bool AliFemtoCorrFctn::PairKinematicWindow(double & /* ktMin */, double & /* ktMax */, double & /* qinvMin */, double & /* qinvMax */) const
+{
+  return false;
+}
+
+inline AliFemtoModelManager* AliFemtoCorrFctn::ModelManager() const
+{
+  return NULL;
+}
+
 
 
 
@@ -215,6 +215,12 @@ void AliFemtoCorrFctn3DLCMSSym::AddMixedPair(AliFemtoPair* pair)
   }
 
 }
+//____________________________
+bool AliFemtoCorrFctn3DLCMSSym::PairKinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const
+{
+  // pairs are only added if they pass the pair selection cut
+  return fPairCut && fPairCut->KinematicWindow(ktMin, ktMax, qinvMin, qinvMax);
+}
 
 void AliFemtoCorrFctn3DLCMSSym::SetUseLCMS(int aUseLCMS)
 {
@@ -33,6 +33,7 @@ public:
   virtual AliFemtoString Report();
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
+  virtual bool PairKinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const;
 
   virtual void Finish();
 
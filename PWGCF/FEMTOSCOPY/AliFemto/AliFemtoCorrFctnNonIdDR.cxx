@@ -282,6 +282,12 @@ void AliFemtoCorrFctnNonIdDR::AddMixedPair(AliFemtoPair* pair)
   //finish adding
 }
 //____________________________
+bool AliFemtoCorrFctnNonIdDR::PairKinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const
+{
+  // pairs are only added if they pass the pair selection cut
+  return fPairCut && fPairCut->KinematicWindow(ktMin, ktMax, qinvMin, qinvMax);
+}
+//____________________________
 void AliFemtoCorrFctnNonIdDR::Write()
 {
   fNumOutP->Write();
@@ -0,0 +1,85 @@
+///
+/// \file AliFemtoFreeList.cxx
+///
+
+#include "AliFemtoFreeList.h"
+
+#include <new>
+
+namespace {
+  /// a free block, linked into the list of its type
+  struct AliFemtoFreeBlock {
+    AliFemtoFreeBlock *fNext;
+  };
+
+  /// free lists of one thread (the calling thread or one of the persistent
+  /// AliFemtoManager workers), returned to the heap when the thread ends
+  struct AliFemtoThreadFreeLists {
+    AliFemtoFreeBlock *fFirst[AliFemtoFreeList::kNTypes];
+    int fN[AliFemtoFreeList::kNTypes];
+
+    AliFemtoThreadFreeLists()
+    {
+      for (int i = 0; i < AliFemtoFreeList::kNTypes; i++) {
+        fFirst[i] = 0;
+        fN[i] = 0;
+      }
+    }
+    ~AliFemtoThreadFreeLists()
+    {
+      for (int i = 0; i < AliFemtoFreeList::kNTypes; i++) {
+        while (fFirst[i]) {
+          AliFemtoFreeBlock *block = fFirst[i];
+          fFirst[i] = block->fNext;
+          ::operator delete(block);
+        }
+        fN[i] = 0;
+      }
+    }
+  };
+
+  thread_local AliFemtoThreadFreeLists gFemtoFreeLists;
+}
+
+int AliFemtoFreeList::fgMaxFreeBlocks = 16384;
+
+//_____________________
+void *AliFemtoFreeList::Allocate(EType type, size_t blockSize, size_t size)
+{
+  // Return a block of the given size, taken from the free list of the
+  // calling thread if possible
+  AliFemtoThreadFreeLists &lists = gFemtoFreeLists;
+  if (size != blockSize || !lists.fFirst[type]) {
+    return ::operator new(size);
+  }
+  AliFemtoFreeBlock *block = lists.fFirst[type];
+  lists.fFirst[type] = block->fNext;
+  lists.fN[type]--;
+  return block;
+}
+//_____________________
+void AliFemtoFreeList::Release(EType type, size_t blockSize, void *block, size_t size)
+{
+  // Put a block back into the free list of the calling thread, or free it
+  // if it has a different size or the list is full
+  if (!block) return;
+  AliFemtoThreadFreeLists &lists = gFemtoFreeLists;
+  if (size != blockSize || lists.fN[type] >= fgMaxFreeBlocks || blockSize < sizeof(AliFemtoFreeBlock)) {
+    ::operator delete(block);
+    return;
+  }
+  AliFemtoFreeBlock *freeBlock = static_cast<AliFemtoFreeBlock*>(block);
+  freeBlock->fNext = lists.fFirst[type];
+  lists.fFirst[type] = freeBlock;
+  lists.fN[type]++;
+}
+//_____________________
+int AliFemtoFreeList::MaxFreeBlocks()
+{
+  return fgMaxFreeBlocks;
+}
+//_____________________
+void AliFemtoFreeList::SetMaxFreeBlocks(int n)
+{
+  fgMaxFreeBlocks = (n > 0) ? n : 0;
+}
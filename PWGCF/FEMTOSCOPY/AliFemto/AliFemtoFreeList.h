@@ -0,0 +1,49 @@
+///
+/// \file AliFemtoFreeList.h
+///
+/// \class AliFemtoFreeList
+/// \brief Per-thread recycling of the memory of short-lived femto objects
+///
+/// Particles and pico events are created for every event and deleted
+/// when they drop out of the mixing buffer. Their class-specific
+/// `operator new` and `operator delete` use this free list, so that the
+/// memory of deleted objects is handed out again instead of going back
+/// to the heap. Each thread keeps its own lists, as analyses may be
+/// processed concurrently (see AliFemtoManager::SetNumberOfThreads).
+/// The worker threads of AliFemtoManager live as long as the manager,
+/// so their lists are reused from event to event. An analysis may run on
+/// a different thread in the next event, i.e. a block can be released
+/// into another list than the one it came from; this only moves blocks
+/// between the lists. At most MaxFreeBlocks() blocks are kept per type
+/// and thread, and the lists are returned to the heap when the thread
+/// ends.
+///
+/// Only blocks of exactly the size of the type are recycled; requests for
+/// a different size (e.g. from derived classes) go to the global heap.
+///
+
+#ifndef ALIFEMTOFREELIST_H
+#define ALIFEMTOFREELIST_H
+
+#include <cstddef>
+
+class AliFemtoFreeList {
+public:
+  /// object types with their own free list
+  enum EType {
+    kParticle = 0,
+    kPicoEvent,
+    kNTypes
+  };
+
+  static void *Allocate(EType type, size_t blockSize, size_t size);
+  static void Release(EType type, size_t blockSize, void *block, size_t size);
+
+  static int MaxFreeBlocks();
+  static void SetMaxFreeBlocks(int n); ///< applies to the lists of all threads
+
+private:
+  static int fgMaxFreeBlocks; ///< maximum number of free blocks kept per type and thread
+};
+
+#endif
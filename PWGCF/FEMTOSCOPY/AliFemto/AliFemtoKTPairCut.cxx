@@ -21,6 +21,7 @@
 #include "AliFemtoKTPairCut.h"
 #include <string>
 #include <cstdio>
+#include <limits>
 #include <TMath.h>
 
 #ifdef __ROOT__
@@ -132,6 +133,16 @@ TList *AliFemtoKTPairCut::ListSettings()
   return tListSetttings;
 }
 
+bool AliFemtoKTPairCut::KinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const
+{
+  // pairs outside the kT range are rejected first thing in Pass()
+  ktMin = fKTMin;
+  ktMax = fKTMax;
+  qinvMin = 0.0;
+  qinvMax = std::numeric_limits<double>::infinity();
+  return true;
+}
+
 void AliFemtoKTPairCut::SetKTRange(double ktmin, double ktmax)
 {
   fKTMin = ktmin;
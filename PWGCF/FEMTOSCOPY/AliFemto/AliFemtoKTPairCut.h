@@ -45,6 +45,7 @@ public:
   void SetPTMin(double ptmin, double ptmax=1000.0);
   virtual bool Pass(const AliFemtoPair* pair);
   virtual bool Pass(const AliFemtoPair* pair, double aRPAngle);
+  virtual bool KinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const;
 
  protected:
   Double_t fKTMin;          // Minimum allowed pair transverse momentum
@@ -8,10 +8,21 @@
 ///////////////////////////////////////////////////////////////////////////
 
 #include "AliFemtoManager.h"
+#include "AliFemtoSimpleAnalysis.h"
+#include "AliFemtoModelManager.h"
 //#include "AliFemtoParticleCollection.h"
 //#include "AliFemtoTrackCut.h"
 //#include "AliFemtoV0Cut.h"
 #include <cstdio>
+#include <set>
+#include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <TROOT.h>
+#include <RVersion.h>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -19,13 +30,96 @@
   /// \endcond
 #endif
 
+/// Worker threads of the concurrent mode. The threads are started once and
+/// wait for the next event; Process() hands them the analyses of an event,
+/// takes part in the work and returns when all analyses are done.
+struct AliFemtoManager::ThreadPool {
+  std::mutex fMutex;
+  std::condition_variable fStart;       // a new event or the stop request
+  std::condition_variable fDone;        // the last worker finished the event
+  std::vector<std::thread> fThreads;
+  std::vector<AliFemtoAnalysis*> fAnalyses;
+  const AliFemtoEvent* fEvent;
+  std::atomic<size_t> fNext;            // next analysis to process
+  unsigned long fGeneration;            // number of events handed to the workers
+  size_t fRunning;                      // workers still busy with the current event
+  bool fStop;
+
+  explicit ThreadPool(size_t nWorkers):
+    fEvent(NULL), fNext(0), fGeneration(0), fRunning(0), fStop(false)
+  {
+    fThreads.reserve(nWorkers);
+    for (size_t t = 0; t < nWorkers; t++) {
+      fThreads.emplace_back(&ThreadPool::Loop, this);
+    }
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStop = true;
+    }
+    fStart.notify_all();
+    for (size_t t = 0; t < fThreads.size(); t++) {
+      fThreads[t].join();
+    }
+  }
+
+  size_t Size() const { return fThreads.size(); }
+
+  void Work()
+  {
+    for (size_t i = fNext++; i < fAnalyses.size(); i = fNext++) {
+      fAnalyses[i]->ProcessEvent(fEvent);
+    }
+  }
+
+  void Loop()
+  {
+    unsigned long seen = 0;
+    std::unique_lock<std::mutex> lock(fMutex);
+    while (true) {
+      fStart.wait(lock, [this, &seen]() { return fStop || fGeneration != seen; });
+      if (fStop) {
+        return;
+      }
+      seen = fGeneration;
+      lock.unlock();
+      Work();
+      lock.lock();
+      if (--fRunning == 0) {
+        fDone.notify_one();
+      }
+    }
+  }
 
+  void Process(AliFemtoAnalysisCollection* collection, const AliFemtoEvent* event)
+  {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fAnalyses.assign(collection->begin(), collection->end());
+      fEvent = event;
+      fNext = 0;
+      fRunning = fThreads.size();
+      fGeneration++;
+    }
+    fStart.notify_all();
+    Work();
+    std::unique_lock<std::mutex> lock(fMutex);
+    fDone.wait(lock, [this]() { return fRunning == 0; });
+  }
+};
 
 //____________________________
 AliFemtoManager::AliFemtoManager():
   fAnalysisCollection(NULL),
   fEventReader(NULL),
-  fEventWriterCollection(NULL)
+  fEventWriterCollection(NULL),
+  fNumberOfThreads(1),
+  fConcurrencyCheckedSize(-1),
+  fConcurrencyAllowed(false),
+  fThreadPool(NULL)
 {
   // default constructor
   fAnalysisCollection = new AliFemtoAnalysisCollection;
@@ -35,7 +129,11 @@ AliFemtoManager::AliFemtoManager():
 AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
   fAnalysisCollection(new AliFemtoAnalysisCollection),
   fEventReader(aManager.fEventReader),
-  fEventWriterCollection(new AliFemtoEventWriterCollection)
+  fEventWriterCollection(new AliFemtoEventWriterCollection),
+  fNumberOfThreads(aManager.fNumberOfThreads),
+  fConcurrencyCheckedSize(-1),
+  fConcurrencyAllowed(false),
+  fThreadPool(NULL)
 {
   // copy constructor
   AliFemtoSimpleAnalysisIterator tAnalysisIter;
@@ -52,6 +150,8 @@ AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
 AliFemtoManager::~AliFemtoManager()
 {
   // destructor
+  // stop the worker threads before the analyses they work on are deleted
+  delete fThreadPool;
   delete fEventReader;
   // now delete each Analysis in the Collection, and then the Collection itself
   AliFemtoSimpleAnalysisIterator tAnalysisIter;
@@ -75,6 +175,11 @@ AliFemtoManager& AliFemtoManager::operator=(const AliFemtoManager& aManager)
   }
 
   fEventReader = aManager.fEventReader;
+  fNumberOfThreads = aManager.fNumberOfThreads;
+  fConcurrencyCheckedSize = -1;
+  fConcurrencyAllowed = false;
+  delete fThreadPool;
+  fThreadPool = NULL;
   AliFemtoSimpleAnalysisIterator tAnalysisIter;
   if (fAnalysisCollection) {
     for (tAnalysisIter=fAnalysisCollection->begin();tAnalysisIter!=fAnalysisCollection->end();tAnalysisIter++){
@@ -242,9 +347,14 @@ int AliFemtoManager::ProcessEvent()
   }
 
   // loop over all the Analysis
-  AliFemtoSimpleAnalysisIterator tAnalysisIter;
-  for (tAnalysisIter=fAnalysisCollection->begin();tAnalysisIter!=fAnalysisCollection->end();tAnalysisIter++){
-    (*tAnalysisIter)->ProcessEvent(currentHbtEvent);
+  if (fNumberOfThreads > 1 && fAnalysisCollection->size() > 1 && CanProcessConcurrently()) {
+    ProcessAnalysesConcurrently(currentHbtEvent);
+  }
+  else {
+    AliFemtoSimpleAnalysisIterator tAnalysisIter;
+    for (tAnalysisIter=fAnalysisCollection->begin();tAnalysisIter!=fAnalysisCollection->end();tAnalysisIter++){
+      (*tAnalysisIter)->ProcessEvent(currentHbtEvent);
+    }
   }
 
   if (currentHbtEvent) {
@@ -256,3 +366,81 @@ int AliFemtoManager::ProcessEvent()
 #endif
   return 0;    // 0 = "good return"
 }       // ProcessEvent
+//____________________________
+void AliFemtoManager::SetNumberOfThreads(int n)
+{
+  // set the number of threads processing the analyses of an event;
+  // the worker threads are (re)started with the next event
+  fNumberOfThreads = (n > 1) ? n : 1;
+  delete fThreadPool;
+  fThreadPool = NULL;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+  if (fNumberOfThreads > 1) ROOT::EnableThreadSafety();
+#endif
+}
+//____________________________
+bool AliFemtoManager::CanProcessConcurrently()
+{
+  // the analyses can run concurrently if they do not share any cut or
+  // correlation function (these hold counters, monitors and histograms),
+  // nor the model manager of a correlation function or its generators
+  // (these keep the state of the current pair, e.g. the k* components).
+  // The check is repeated whenever the number of analyses changed.
+  if (fConcurrencyCheckedSize == (int) fAnalysisCollection->size()) {
+    return fConcurrencyAllowed;
+  }
+  fConcurrencyCheckedSize = fAnalysisCollection->size();
+  fConcurrencyAllowed = false;
+
+  std::set<const void*> used;
+  AliFemtoSimpleAnalysisIterator tAnalysisIter;
+  for (tAnalysisIter=fAnalysisCollection->begin();tAnalysisIter!=fAnalysisCollection->end();tAnalysisIter++){
+    AliFemtoSimpleAnalysis *analysis = dynamic_cast<AliFemtoSimpleAnalysis*>(*tAnalysisIter);
+    if (!analysis) {
+      cout << "W-AliFemtoManager: analysis is not an AliFemtoSimpleAnalysis, processing analyses sequentially" << endl;
+      return false;
+    }
+
+    // objects of this analysis; the two particle cuts may be identical
+    std::set<const void*> own;
+    own.insert(analysis->EventCut());
+    own.insert(analysis->FirstParticleCut());
+    own.insert(analysis->SecondParticleCut());
+    own.insert(analysis->PairCut());
+    own.insert(analysis->MixingBuffer());
+    AliFemtoCorrFctnIterator tCorrFctnIter;
+    for (tCorrFctnIter=analysis->CorrFctnCollection()->begin();tCorrFctnIter!=analysis->CorrFctnCollection()->end();tCorrFctnIter++){
+      own.insert(*tCorrFctnIter);
+      // several correlation functions of one analysis may use the same model manager
+      AliFemtoModelManager *modelManager = (*tCorrFctnIter)->ModelManager();
+      if (modelManager) {
+        own.insert(modelManager);
+        own.insert(modelManager->GetWeightGenerator());
+        own.insert(modelManager->GetFreezeOutGenerator());
+      }
+    }
+    own.erase((const void*) NULL);
+
+    std::set<const void*>::const_iterator tIter;
+    for (tIter=own.begin();tIter!=own.end();tIter++){
+      if (!used.insert(*tIter).second) {
+        cout << "W-AliFemtoManager: analyses share cuts, correlation functions or model managers, processing analyses sequentially" << endl;
+        return false;
+      }
+    }
+  }
+
+  fConcurrencyAllowed = true;
+  return true;
+}
+//____________________________
+void AliFemtoManager::ProcessAnalysesConcurrently(const AliFemtoEvent* event)
+{
+  // pass the event to all analyses, distributed dynamically over the
+  // calling thread and the fNumberOfThreads-1 worker threads. Each
+  // analysis receives the events in the same order as in sequential mode.
+  if (!fThreadPool) {
+    fThreadPool = new ThreadPool(fNumberOfThreads - 1);
+  }
+  fThreadPool->Process(fAnalysisCollection, event);
+}
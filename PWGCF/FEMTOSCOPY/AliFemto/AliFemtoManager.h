@@ -43,12 +43,33 @@
 /// operator private prevents potential dangling pointer (segfault)
 /// errors.
 ///
+/// With `SetNumberOfThreads(n)`, n > 1, the analyses are processed
+/// concurrently for each event by the calling thread and n-1 worker
+/// threads, which are started with the first event and kept until the
+/// manager is destroyed. Every analysis keeps its own mixing buffer,
+/// cuts and correlation functions and sees the events in the same
+/// order as in sequential mode, so the output does not depend on the
+/// number of threads. This requires that no cut, correlation function
+/// or model manager (and its weight and freeze-out generators) is
+/// shared between analyses and that all analyses derive from
+/// AliFemtoSimpleAnalysis; otherwise the manager falls back to
+/// sequential processing.
+///
 class AliFemtoManager {
 
 private:
+  struct ThreadPool;
+
   AliFemtoAnalysisCollection* fAnalysisCollection;       ///< Collection of analyzes
   AliFemtoEventReader*        fEventReader;              ///< Event reader
   AliFemtoEventWriterCollection* fEventWriterCollection; ///< Event writer collection
+  int fNumberOfThreads;                                  ///< Number of threads processing the analyses (<= 1: sequential)
+  int fConcurrencyCheckedSize;                           ///< Number of analyses at the last concurrency check (-1: not checked)
+  bool fConcurrencyAllowed;                              ///< Result of the last concurrency check
+  ThreadPool* fThreadPool;                               //!<! Worker threads, started with the first concurrent event
+
+  bool CanProcessConcurrently();                         ///< Checks that the analyses share no cuts, correlation functions or model managers
+  void ProcessAnalysesConcurrently(const AliFemtoEvent* event);
 
 public:
   AliFemtoManager();
@@ -70,6 +91,10 @@ public:
   AliFemtoEventReader* EventReader();
   void SetEventReader(AliFemtoEventReader* r);
 
+  /// Process the analyses of each event on n threads (n <= 1: sequential, the default)
+  void SetNumberOfThreads(int n);
+  int NumberOfThreads() const;
+
   /// Calls `Init()` on all owned EventWriters
   ///
   /// Returns 0 for success, 1 for failure.
@@ -99,4 +124,6 @@ inline void AliFemtoManager::SetEventWriter(AliFemtoEventWriter* writer){fEventW
 inline AliFemtoEventReader* AliFemtoManager::EventReader(){return fEventReader;}
 inline void AliFemtoManager::SetEventReader(AliFemtoEventReader* reader){fEventReader = reader;}
 
+inline int AliFemtoManager::NumberOfThreads() const {return fNumberOfThreads;}
+
 #endif
@@ -38,6 +38,11 @@ public:
 
   virtual bool Pass(const AliFemtoPair* pair) = 0;  ///< true if pair passes, false if not
 
+  /// Window in pair kT and |qinv| outside of which Pass() returns false
+  /// without any other effect, used to reject pairs before evaluating the
+  /// full cut. Returns false if the cut has no such window (the default).
+  virtual bool KinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const;
+
   virtual AliFemtoString Report() = 0;              ///< user-written method to return string describing cuts
   virtual TList *ListSettings() = 0;                ///< Return a TList of settings
 
@@ -68,6 +73,8 @@ inline AliFemtoPairCut& AliFemtoPairCut::operator=(const AliFemtoPairCut &aCut)
 
 inline void AliFemtoPairCut::EventBegin(const AliFemtoEvent* /* aEvent */ ) { /* no-op */ }
 
+inline bool AliFemtoPairCut::KinematicWindow(double & /* ktMin */, double & /* ktMax */, double & /* qinvMin */, double & /* qinvMax */) const { return false; }
+
 inline void AliFemtoPairCut::EventEnd(const AliFemtoEvent* /* aEvent */ ) { /* no-op */ }
 
 #endif
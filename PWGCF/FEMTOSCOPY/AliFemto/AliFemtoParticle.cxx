@@ -19,6 +19,36 @@ double AliFemtoParticle::fgPrimPpPar0 = 0.;
 double AliFemtoParticle::fgPrimPpPar1 = 0.;
 double AliFemtoParticle::fgPrimPpPar2 = 0.;
 
+// returned for the TPC points of particles which are not V0s
+static const AliFemtoThreeVector kNullTpcPoint;
+
+//_____________________
+AliFemtoParticleV0Geometry::AliFemtoParticleV0Geometry() :
+  fPrimaryVertex(),
+  fSecondaryVertex(),
+  fHelixV0Pos(),
+  fTpcV0PosEntrancePoint(),
+  fTpcV0PosExitPoint(),
+  fHelixV0Neg(),
+  fTpcV0NegEntrancePoint(),
+  fTpcV0NegExitPoint()
+{
+  // Default constructor
+}
+//_____________________
+AliFemtoParticleV0Geometry::AliFemtoParticleV0Geometry(const AliFemtoV0 &hbtV0) :
+  fPrimaryVertex(hbtV0.PrimaryVertex()),
+  fSecondaryVertex(hbtV0.DecayVertexV0()),
+  fHelixV0Pos(hbtV0.HelixPos()),
+  fTpcV0PosEntrancePoint(),
+  fTpcV0PosExitPoint(),
+  fHelixV0Neg(hbtV0.HelixNeg()),
+  fTpcV0NegEntrancePoint(),
+  fTpcV0NegExitPoint()
+{
+  // Constructor from V0
+}
+
 int TpcLocalTransform(AliFmThreeVectorD &xgl,
                       int &iSector,
                       int &iPadrow,
@@ -35,14 +65,7 @@ AliFemtoParticle::AliFemtoParticle() :
   fFourMomentum(),
   fHelix(),
   fHiddenInfo(NULL),
-  fPrimaryVertex(),
-  fSecondaryVertex(),
-  fHelixV0Pos(),
-  fTpcV0PosEntrancePoint(),
-  fTpcV0PosExitPoint(),
-  fHelixV0Neg(),
-  fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fV0Geometry(NULL)
 {
   // Default constructor
   std::fill_n(fPurity, 6, 0.0);
@@ -56,17 +79,12 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoParticle &aParticle):
   fFourMomentum(aParticle.fFourMomentum),
   fHelix(aParticle.fHelix),
   fHiddenInfo(NULL),
-  fPrimaryVertex(aParticle.fPrimaryVertex),
-  fSecondaryVertex(aParticle.fSecondaryVertex),
-  fHelixV0Pos(aParticle.fHelixV0Pos),
-  fTpcV0PosEntrancePoint(aParticle.fTpcV0PosEntrancePoint),
-  fTpcV0PosExitPoint(aParticle.fTpcV0PosExitPoint),
-  fHelixV0Neg(aParticle.fHelixV0Neg),
-  fTpcV0NegEntrancePoint(aParticle.fTpcV0NegEntrancePoint),
-  fTpcV0NegExitPoint(aParticle.fTpcV0NegExitPoint)
+  fV0Geometry(NULL)
 {
   // Copy constructor
   memcpy(fPurity, aParticle.fPurity, sizeof(fPurity));
+  if (aParticle.fV0Geometry)
+    fV0Geometry = new AliFemtoParticleV0Geometry(*aParticle.fV0Geometry);
   if (aParticle.fTrack)
     fTrack = new AliFemtoTrack(*aParticle.fTrack);
   if (aParticle.fV0)
@@ -89,6 +107,7 @@ AliFemtoParticle::~AliFemtoParticle()
   if(fKink)   delete fKink;
   if(fXi)     delete fXi;
   if(fHiddenInfo) delete fHiddenInfo;
+  delete fV0Geometry;
 }
 //_____________________
 AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const double &mass):
@@ -99,14 +118,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const do
   fFourMomentum(::sqrt(hbtTrack->P().Mag2() + mass*mass), hbtTrack->P()),
   fHelix(hbtTrack->Helix()),
   fHiddenInfo(NULL),
-  fPrimaryVertex(),
-  fSecondaryVertex(),
-  fHelixV0Pos(),
-  fTpcV0PosEntrancePoint(),
-  fTpcV0PosExitPoint(),
-  fHelixV0Neg(),
-  fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fV0Geometry(NULL)
 {
   // Constructor from normal track
   /* TO JA ODZNACZYLEM NIE WIEM DLACZEGO
@@ -133,14 +145,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoV0 *const hbtV0, const double &
   fFourMomentum(::sqrt(hbtV0->MomV0().Mag2() + mass*mass), hbtV0->MomV0()),
   fHelix(),
   fHiddenInfo(NULL),
-  fPrimaryVertex(hbtV0->PrimaryVertex()),
-  fSecondaryVertex(hbtV0->DecayVertexV0()),
-  fHelixV0Pos(hbtV0->HelixPos()),
-  fTpcV0PosEntrancePoint(),
-  fTpcV0PosExitPoint(),
-  fHelixV0Neg(hbtV0->HelixNeg()),
-  fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fV0Geometry(new AliFemtoParticleV0Geometry(*hbtV0))
 {
   // Constructor from V0
 
@@ -160,14 +165,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoKink *const hbtKink, const doub
 //   fNominalTpcExitPoint(0),
 //   fNominalTpcEntrancePoint(0),
   fHiddenInfo(NULL),
-  fPrimaryVertex(),
-  fSecondaryVertex(),
-  fHelixV0Pos(),
-  fTpcV0PosEntrancePoint(),
-  fTpcV0PosExitPoint(),
-  fHelixV0Neg(),
-  fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fV0Geometry(NULL)
 {
   // Constructor from Kink
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -184,14 +182,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoXi *const hbtXi, const double &
 //   fNominalTpcExitPoint(0),
 //   fNominalTpcEntrancePoint(0),
   fHiddenInfo(NULL),
-  fPrimaryVertex(),
-  fSecondaryVertex(),
-  fHelixV0Pos(),
-  fTpcV0PosEntrancePoint(),
-  fTpcV0PosExitPoint(),
-  fHelixV0Neg(),
-  fTpcV0NegEntrancePoint(),
-  fTpcV0NegExitPoint()
+  fV0Geometry(NULL)
 {
   // Constructor from Xi
   for (int ip = 0; ip < 6; ip++) fPurity[ip] = 0.0;
@@ -226,8 +217,6 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
   fFourMomentum = aParticle.fFourMomentum;
   fHelix = aParticle.fHelix;
 
-  fPrimaryVertex = aParticle.fPrimaryVertex;
-  fSecondaryVertex = aParticle.fSecondaryVertex;
 
     //   for (int iter=0; iter<11; iter++)
     //     fNominalPosSample[iter] = aParticle.fNominalPosSample[iter];
@@ -273,12 +262,10 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
   for (int iter = 0; iter < 6; iter++)
     fPurity[iter] = aParticle.fPurity[iter];
 
-  fHelixV0Pos = aParticle.fHelixV0Pos;
-  fTpcV0PosEntrancePoint = aParticle.fTpcV0PosEntrancePoint;
-  fTpcV0PosExitPoint = aParticle.fTpcV0PosExitPoint;
-  fHelixV0Neg = aParticle.fHelixV0Neg;
-  fTpcV0NegEntrancePoint = aParticle.fTpcV0NegEntrancePoint;
-  fTpcV0NegExitPoint = aParticle.fTpcV0NegExitPoint;
+  delete fV0Geometry;
+  fV0Geometry = NULL;
+  if (aParticle.fV0Geometry)
+    fV0Geometry = new AliFemtoParticleV0Geometry(*aParticle.fV0Geometry);
 
   return *this;
 }
@@ -608,21 +595,21 @@ double AliFemtoParticle::GetProtonPurity()
 //_____________________
 const AliFemtoThreeVector &AliFemtoParticle::TpcV0PosExitPoint() const
 {
-  return fTpcV0PosExitPoint;
+  return fV0Geometry ? fV0Geometry->fTpcV0PosExitPoint : kNullTpcPoint;
 }
 //_____________________
 const AliFemtoThreeVector &AliFemtoParticle::TpcV0PosEntrancePoint() const
 {
-  return fTpcV0PosEntrancePoint;
+  return fV0Geometry ? fV0Geometry->fTpcV0PosEntrancePoint : kNullTpcPoint;
 }
 //______________________
 const AliFemtoThreeVector &AliFemtoParticle::TpcV0NegExitPoint() const
 {
-  return fTpcV0NegExitPoint;
+  return fV0Geometry ? fV0Geometry->fTpcV0NegExitPoint : kNullTpcPoint;
 }
 //_____________________
 const AliFemtoThreeVector &AliFemtoParticle::TpcV0NegEntrancePoint() const
 {
-  return fTpcV0NegEntrancePoint;
+  return fV0Geometry ? fV0Geometry->fTpcV0NegEntrancePoint : kNullTpcPoint;
 }
 //______________________
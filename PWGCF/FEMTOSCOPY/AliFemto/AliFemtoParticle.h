@@ -16,11 +16,30 @@
 #include "AliFemtoKink.h"
 #include "AliFemtoXi.h"
 #include "AliFmPhysicalHelixD.h"
+#include "AliFemtoFreeList.h"
 
 // ***
 class AliFemtoHiddenInfo;
 // ***
 
+/// Geometry of V0 particles, kept out of line as it is only filled for
+/// V0s and not needed in the pair loops
+struct AliFemtoParticleV0Geometry {
+  AliFemtoParticleV0Geometry();
+  explicit AliFemtoParticleV0Geometry(const AliFemtoV0 &hbtV0);
+
+  AliFemtoThreeVector fPrimaryVertex;   // primary vertex of V0
+  AliFemtoThreeVector fSecondaryVertex; // secondary vertex of V0
+
+  AliFmPhysicalHelixD fHelixV0Pos;            // helix for positive V0 daughter
+  AliFemtoThreeVector fTpcV0PosEntrancePoint; // positive V0 daughter entrance point to TPC
+  AliFemtoThreeVector fTpcV0PosExitPoint;     // positive V0 daughter exit point from TPC
+
+  AliFmPhysicalHelixD fHelixV0Neg;            // helix for negative V0 daughter
+  AliFemtoThreeVector fTpcV0NegEntrancePoint; // negative V0 daughter entrance point to TPC
+  AliFemtoThreeVector fTpcV0NegExitPoint;     // negative V0 daughter exit point from TPC
+};
+
 class AliFemtoParticle {
 public:
   AliFemtoParticle();
@@ -33,6 +52,10 @@ public:
 
   AliFemtoParticle &operator=(const AliFemtoParticle &aParticle);
 
+  /// particles are allocated from a per-thread free list, see AliFemtoFreeList
+  static void *operator new(size_t size);
+  static void operator delete(void *p, size_t size);
+
   const AliFemtoLorentzVector& FourMomentum() const;
 
   AliFmPhysicalHelixD& Helix();
@@ -115,19 +138,19 @@ private:
   static double fgPrimPpPar1;  // purity parameterization parameter
   static double fgPrimPpPar2;  // purity parameterization parameter
 
-  // For V0 Daugthers TpcEntrance/ExitPoints
-  AliFemtoThreeVector fPrimaryVertex;   // primary vertex of V0
-  AliFemtoThreeVector fSecondaryVertex; // secondary vertex of V0
-
-  AliFmPhysicalHelixD fHelixV0Pos;            // helix for positive V0 daughter
-  AliFemtoThreeVector fTpcV0PosEntrancePoint; // positive V0 daughter entrance point to TPC
-  AliFemtoThreeVector fTpcV0PosExitPoint;     // positive V0 daughter exit point from TPC
-
-  AliFmPhysicalHelixD fHelixV0Neg;            // helix for negative V0 daughter
-  AliFemtoThreeVector fTpcV0NegEntrancePoint; // negative V0 daughter entrance point to TPC
-  AliFemtoThreeVector fTpcV0NegExitPoint;     // negative V0 daughter exit point from TPC
+  // For V0 Daugthers TpcEntrance/ExitPoints, NULL for other particles
+  AliFemtoParticleV0Geometry *fV0Geometry; // out-of-line geometry of V0 particles
 };
 
+inline void *AliFemtoParticle::operator new(size_t size)
+{
+  return AliFemtoFreeList::Allocate(AliFemtoFreeList::kParticle, sizeof(AliFemtoParticle), size);
+}
+inline void AliFemtoParticle::operator delete(void *p, size_t size)
+{
+  AliFemtoFreeList::Release(AliFemtoFreeList::kParticle, sizeof(AliFemtoParticle), p, size);
+}
+
 inline AliFemtoTrack *AliFemtoParticle::Track() const
 {
   return fTrack;
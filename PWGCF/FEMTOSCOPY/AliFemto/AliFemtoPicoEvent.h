@@ -43,6 +43,7 @@
 #define ALIFEMTOPICOEVENT_H
 
 #include "AliFemtoParticleCollection.h"
+#include "AliFemtoFreeList.h"
 
 class AliFemtoPicoEvent{
 public:
@@ -52,6 +53,10 @@ public:
 
   AliFemtoPicoEvent& operator=(const AliFemtoPicoEvent& aPicoEvent);
 
+  // pico events are allocated from a per-thread free list, see AliFemtoFreeList
+  static void* operator new(size_t size);
+  static void operator delete(void* p, size_t size);
+
   /* may want to have other stuff in here, like where is primary vertex */
 
   AliFemtoParticleCollection* FirstParticleCollection();
@@ -68,4 +73,7 @@ inline AliFemtoParticleCollection* AliFemtoPicoEvent::FirstParticleCollection(){
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::SecondParticleCollection(){return fSecondParticleCollection;}
 inline AliFemtoParticleCollection* AliFemtoPicoEvent::ThirdParticleCollection(){return fThirdParticleCollection;}
 
+inline void* AliFemtoPicoEvent::operator new(size_t size){return AliFemtoFreeList::Allocate(AliFemtoFreeList::kPicoEvent,sizeof(AliFemtoPicoEvent),size);}
+inline void AliFemtoPicoEvent::operator delete(void* p, size_t size){AliFemtoFreeList::Release(AliFemtoFreeList::kPicoEvent,sizeof(AliFemtoPicoEvent),p,size);}
+
 #endif
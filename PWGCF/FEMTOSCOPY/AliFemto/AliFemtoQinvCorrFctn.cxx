@@ -326,6 +326,12 @@ void AliFemtoQinvCorrFctn::AddMixedPair(AliFemtoPair* pair){
   }
 //_______________________________________________________________
 
+}
+//____________________________
+bool AliFemtoQinvCorrFctn::PairKinematicWindow(double &ktMin, double &ktMax, double &qinvMin, double &qinvMax) const
+{
+  // pairs are only added if they pass the pair selection cut
+  return fPairCut && fPairCut->KinematicWindow(ktMin, ktMax, qinvMin, qinvMax);
 }
 //____________________________
 void AliFemtoQinvCorrFctn::Write(){
@@ -13,6 +13,8 @@
 #include <string>
 #include <iostream>
 #include <iterator>
+#include <vector>
+#include <cmath>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -25,6 +27,35 @@ AliFemtoParticleCut* copyTheCut(AliFemtoParticleCut*);
 AliFemtoPairCut*     copyTheCut(AliFemtoPairCut*);
 AliFemtoCorrFctn*    copyTheCorrFctn(AliFemtoCorrFctn*);
 
+namespace {
+
+/// Four-momenta (px, py, pz, E) of a particle collection in a flat array
+void FillFourMomenta(const AliFemtoParticleCollection *collection, std::vector<double> &momenta)
+{
+  momenta.clear();
+  momenta.reserve(4 * collection->size());
+  for (const auto &particle : *collection) {
+    const AliFemtoLorentzVector &p = particle->FourMomentum();
+    momenta.push_back(p.px());
+    momenta.push_back(p.py());
+    momenta.push_back(p.pz());
+    momenta.push_back(p.e());
+  }
+}
+
+/// Whether pair kT and |qinv| are inside a window (ktMin, ktMax, qinvMin,
+/// qinvMax). The window is widened by a small margin, so that rounding
+/// differences to AliFemtoPair::KT() and QInv() never reject a pair which
+/// the full cut would accept.
+bool InKinematicWindow(double kt, double qinv, const double *window)
+{
+  const double margin = 1e-9;
+  return kt >= window[0] - margin && kt <= window[1] + margin
+      && qinv >= window[2] - margin && qinv <= window[3] + margin;
+}
+
+}
+
 
 /// Generalized particle collection filler function - called by
 /// FillParticleCollection()
@@ -171,7 +202,8 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPairKinematicPreselection(kFALSE)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -193,7 +225,8 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPairKinematicPreselection(a.fPairKinematicPreselection)
 {
   /// Copy constructor
 
@@ -390,6 +423,7 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fVerbose = aAna.fVerbose;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
+  fPairKinematicPreselection = aAna.fPairKinematicPreselection;
 
   return *this;
 }
@@ -604,13 +638,43 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
     tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
   }
 
+  // Cheap pre-selection in pair kT and |qinv|, computed from flat arrays
+  // of the four-momenta: pairs outside the window of the pair cut fail it
+  // anyway, and (optionally) pairs outside the windows of all correlation
+  // functions are not added anywhere. Not done with pair monitors, which
+  // have to see every pair.
+  double tCutWindow[4];
+  const bool tUseCutWindow = !enablePairMonitors
+                          && fPairCut->KinematicWindow(tCutWindow[0], tCutWindow[1], tCutWindow[2], tCutWindow[3]);
+
+  std::vector<double> tCorrFctnWindows;
+  bool tUseCorrFctnWindows = !enablePairMonitors && fPairKinematicPreselection && !fCorrFctnCollection->empty();
+  for (auto &tCorrFctn : *fCorrFctnCollection) {
+    if (!tUseCorrFctnWindows) break;
+    double tWindow[4];
+    if (!tCorrFctn->PairKinematicWindow(tWindow[0], tWindow[1], tWindow[2], tWindow[3])) {
+      tUseCorrFctnWindows = false;
+      break;
+    }
+    tCorrFctnWindows.insert(tCorrFctnWindows.end(), tWindow, tWindow + 4);
+  }
+
+  const bool tUsePreselection = tUseCutWindow || tUseCorrFctnWindows;
+  std::vector<double> tMomenta1, tMomenta2;
+  if (tUsePreselection) {
+    FillFourMomenta(partCollection1, tMomenta1);
+    if (partCollection2) FillFourMomenta(partCollection2, tMomenta2);
+  }
+  const std::vector<double> &tInnerMomenta = partCollection2 ? tMomenta2 : tMomenta1;
+
   // Create the pair outside the loop - only allocate once
   AliFemtoPair* tPair = new AliFemtoPair;
 
   // Begin the outer loop
+  size_t tIndex1 = 0;
   for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
                                      tPartIter1 != tEndOuterLoop;
-                                     ++tPartIter1) {
+                                     ++tPartIter1, ++tIndex1) {
 
     // If analyzing identical particles, start inner loop at the particle
     // after the current outer loop position, (loops until end)
@@ -625,9 +689,10 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
     }
 
     // Begin the inner loop
+    size_t tIndex2 = partCollection2 ? 0 : tIndex1 + 1;
     for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
                                        tPartIter2 != tEndInnerLoop;
-                                     ++tPartIter2) {
+                                     ++tPartIter2, ++tIndex2) {
       // If we have two collections - only set the second track
       if (partCollection2 != nullptr) {
         tPair->SetTrack2(*tPartIter2);
@@ -639,6 +704,33 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
         swpart = !swpart;
       }
 
+      // kT and |qinv| are symmetric in the two particles
+      if (tUsePreselection) {
+        const double *p1 = &tMomenta1[4 * tIndex1],
+                     *p2 = &tInnerMomenta[4 * tIndex2];
+        const double px = p1[0] + p2[0],
+                     py = p1[1] + p2[1];
+        const double kt = 0.5 * std::sqrt(px * px + py * py);
+        const double dx = p1[0] - p2[0],
+                     dy = p1[1] - p2[1],
+                     dz = p1[2] - p2[2],
+                     de = p1[3] - p2[3];
+        const double qinv = std::sqrt(std::fabs(de * de - (dx * dx + dy * dy + dz * dz)));
+
+        if (tUseCutWindow && !InKinematicWindow(kt, qinv, tCutWindow)) {
+          continue;
+        }
+        if (tUseCorrFctnWindows) {
+          bool tInAnyWindow = false;
+          for (size_t iw = 0; iw < tCorrFctnWindows.size() && !tInAnyWindow; iw += 4) {
+            tInAnyWindow = InKinematicWindow(kt, qinv, &tCorrFctnWindows[iw]);
+          }
+          if (!tInAnyWindow) {
+            continue;
+          }
+        }
+      }
+
       // check if the pair passes the cut
       bool tmpPassPair = fPairCut->Pass(tPair);
 
@@ -99,6 +99,13 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Skip pairs outside the kT/|qinv| windows of all correlation
+  /// functions (see AliFemtoCorrFctn::PairKinematicWindow) before the
+  /// pair cut is evaluated. Only the pass/fail counters of the pair cut
+  /// change, as such pairs are not added to any correlation function.
+  void SetPairKinematicPreselection(Bool_t aEnable);
+  Bool_t PairKinematicPreselection() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -177,6 +184,7 @@ protected:
   Bool_t fVerbose;
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
+  Bool_t fPairKinematicPreselection;                 ///< Skip pairs outside the windows of all correlation functions
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -305,4 +313,14 @@ inline void AliFemtoSimpleAnalysis::SetEnablePairMonitors(Bool_t aEnable)
   fEnablePairMonitors = aEnable;
 }
 
+inline void AliFemtoSimpleAnalysis::SetPairKinematicPreselection(Bool_t aEnable)
+{
+  fPairKinematicPreselection = aEnable;
+}
+
+inline Bool_t AliFemtoSimpleAnalysis::PairKinematicPreselection() const
+{
+  return fPairKinematicPreselection;
+}
+
 #endif
@@ -78,6 +78,7 @@ public:
   
   /// Set the MC model manager
   virtual void SetManager(AliFemtoModelManager *);
+  virtual AliFemtoModelManager* ModelManager() const { return fManager; }
   
   virtual AliFemtoString Report();
   
@@ -24,6 +24,7 @@ public:
   AliFemtoModelCorrFctnWithWeights& operator=(const AliFemtoModelCorrFctnWithWeights& aCorrFctn);
 
   virtual void ConnectToManager(AliFemtoModelManager *aManager);
+  virtual AliFemtoModelManager* ModelManager() const { return fManager; }
 
   virtual AliFemtoString Report();
 
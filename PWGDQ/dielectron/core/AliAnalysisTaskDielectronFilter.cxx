@@ -232,6 +232,8 @@ void AliAnalysisTaskDielectronFilter::UserCreateOutputObjects()
   }
   if(fStoreRotatedPairs) fDielectron->SetStoreRotatedPairs(kTRUE);
   fDielectron->SetDontClearArrays();
+  // the pair arrays are written to the AOD and must own their pairs
+  fDielectron->SetUsePairPool(kFALSE);
   fDielectron->Init();
 
   Int_t nbins=kNbinsEvent+2;
@@ -42,6 +42,8 @@ The names are available via the function PairClassName(Int_t i)
 //                                                                       //
 ///////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <TString.h>
 #include <TList.h>
 #include <TMath.h>
@@ -76,6 +78,110 @@ The names are available via the function PairClassName(Int_t i)
 
 ClassImp(AliDielectron)
 
+namespace {
+  //________________________________________________________________
+  class AliDielectronLegIndex {
+    //
+    // Legs of one track array sorted in eta, to find the possible prefilter
+    // partners of a track inside an (eta, phi) neighbourhood without looping
+    // over the full array. Legs with undefined eta or phi are always returned.
+    //
+  public:
+    AliDielectronLegIndex(const TObjArray &arr, Double_t dEta, Double_t dPhi) :
+      fN(0), fNAlways(0), fDEta(dEta), fDPhi(dPhi),
+      fIdx(0x0), fAlways(0x0), fEta(0x0), fPhi(0x0)
+    {
+      const Int_t ntracks=arr.GetEntriesFast();
+      Double_t *eta=new Double_t[ntracks+1];
+      Int_t *sorted=new Int_t[ntracks+1];
+      fIdx=new Int_t[ntracks+1];
+      fAlways=new Int_t[ntracks+1];
+      fEta=new Double_t[ntracks+1];
+      fPhi=new Double_t[ntracks+1];
+      Int_t nvalid=0;
+      for (Int_t itrack=0; itrack<ntracks; ++itrack){
+        const AliVParticle *track=static_cast<const AliVParticle*>(arr.UncheckedAt(itrack));
+        if (!track) continue;
+        const Double_t trkEta=track->Eta();
+        fPhi[itrack]=track->Phi();
+        if (!TMath::Finite(trkEta) || !TMath::Finite(fPhi[itrack])) {
+          fAlways[fNAlways++]=itrack;
+          continue;
+        }
+        eta[nvalid]=trkEta;
+        fIdx[nvalid++]=itrack;
+      }
+      TMath::Sort(nvalid, eta, sorted, kFALSE);
+      Int_t *idx=new Int_t[nvalid+1];
+      for (Int_t i=0; i<nvalid; ++i){
+        fEta[i]=eta[sorted[i]];
+        idx[i]=fIdx[sorted[i]];
+      }
+      for (Int_t i=0; i<nvalid; ++i) fIdx[i]=idx[i];
+      fN=nvalid;
+      delete [] idx;
+      delete [] sorted;
+      delete [] eta;
+    }
+    ~AliDielectronLegIndex()
+    {
+      delete [] fIdx;
+      delete [] fAlways;
+      delete [] fEta;
+      delete [] fPhi;
+    }
+
+    Int_t GetPartners(const AliVParticle *track, Int_t end, Int_t *partners) const
+    {
+      //
+      // fill the indices (< end, in ascending order) of all legs in the
+      // neighbourhood of track, return their number
+      //
+      Int_t npartners=0;
+      for (Int_t i=0; i<fNAlways; ++i) if (fAlways[i]<end) partners[npartners++]=fAlways[i];
+
+      const Double_t eta=track->Eta();
+      const Double_t phi=track->Phi();
+      if (!TMath::Finite(eta) || !TMath::Finite(phi)) {
+        // no neighbourhood defined, all legs are candidates
+        for (Int_t i=0; i<fN; ++i) if (fIdx[i]<end) partners[npartners++]=fIdx[i];
+      } else {
+        // first leg with eta >= eta-fDEta
+        Int_t lo=0, hi=fN;
+        while (lo<hi) {
+          const Int_t mid=(lo+hi)/2;
+          if (fEta[mid]<eta-fDEta) lo=mid+1;
+          else hi=mid;
+        }
+        for (Int_t i=lo; i<fN && fEta[i]<=eta+fDEta; ++i){
+          const Int_t itrack=fIdx[i];
+          if (itrack>=end) continue;
+          Double_t dphi=TMath::Abs(phi-fPhi[itrack]);
+          if (dphi>TMath::Pi()) dphi=TMath::TwoPi()-dphi;
+          if (dphi>fDPhi) continue;
+          partners[npartners++]=itrack;
+        }
+      }
+      // keep the pairing order of the full loop
+      std::sort(partners, partners+npartners);
+      return npartners;
+    }
+
+  private:
+    Int_t     fN;        // number of legs with defined eta and phi
+    Int_t     fNAlways;  // number of legs with undefined eta or phi
+    Double_t  fDEta;     // half width of the neighbourhood in eta
+    Double_t  fDPhi;     // half width of the neighbourhood in phi
+    Int_t    *fIdx;      // [fN] track array index, sorted in eta
+    Int_t    *fAlways;   // [fNAlways] track array index of legs without defined eta or phi
+    Double_t *fEta;      // [fN] sorted eta
+    Double_t *fPhi;      // phi by track array index
+
+    AliDielectronLegIndex(const AliDielectronLegIndex &c);
+    AliDielectronLegIndex &operator=(const AliDielectronLegIndex &c);
+  };
+}
+
 const char* AliDielectron::fgkTrackClassNames[4] = {
   "ev1+",
   "ev1-",
@@ -160,6 +266,16 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPreFilterDeltaEta(-1.),
+  fPreFilterDeltaPhi(-1.),
+  fEventPlanePreFilterDeltaEta(-1.),
+  fEventPlanePreFilterDeltaPhi(-1.),
+  fUsePairPool(kTRUE),
+  fPairPool("AliDielectronPair",1000),
+  fNPairPool(0),
+  fPairPoolHighWater(0),
+  fPairClassHistos(0x0),
+  fPairClassGeneration(0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -237,6 +353,16 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fPreFilterDeltaEta(-1.),
+  fPreFilterDeltaPhi(-1.),
+  fEventPlanePreFilterDeltaEta(-1.),
+  fEventPlanePreFilterDeltaPhi(-1.),
+  fUsePairPool(kTRUE),
+  fPairPool("AliDielectronPair",1000),
+  fNPairPool(0),
+  fPairPoolHighWater(0),
+  fPairClassHistos(0x0),
+  fPairClassGeneration(0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -746,8 +872,9 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
 
   //Fill event information
   if (ev){
-    if (fHistos->GetHistogramList()->FindObject("Event")) {
-      fHistos->FillClass("Event", AliDielectronVarManager::kNMaxValues, AliDielectronVarManager::GetData());
+    const Int_t evClass=fHistos->GetClassIndex("Event");
+    if (evClass>=0) {
+      fHistos->FillClass(evClass, AliDielectronVarManager::kNMaxValues, AliDielectronVarManager::GetData());
     }
   }
 
@@ -756,59 +883,78 @@ void AliDielectron::FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly)
     className2.Form("Track_%s",fgkPairClassNames[1]);  // unlike sign, SE only
     for (Int_t i=0; i<4; ++i){
       className.Form("Track_%s",fgkTrackClassNames[i]);
-      Bool_t mergedtrkClass=fHistos->GetHistogramList()->FindObject(className2.Data())!=0x0;
-      Bool_t trkClass=fHistos->GetHistogramList()->FindObject(className.Data())!=0x0;
-      if (!trkClass && !mergedtrkClass) continue;
+      const Int_t mergedtrkClass=fHistos->GetClassIndex(className2.Data());
+      const Int_t trkClass=fHistos->GetClassIndex(className.Data());
+      if (trkClass<0 && mergedtrkClass<0) continue;
       Int_t ntracks=fTracks[i].GetEntriesFast();
       for (Int_t itrack=0; itrack<ntracks; ++itrack){
         AliDielectronVarManager::Fill(fTracks[i].UncheckedAt(itrack), values);
-        if(trkClass)
-          fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
-        if(mergedtrkClass && i<2)
-          fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values); //only ev1
+        if(trkClass>=0)
+          fHistos->FillClass(trkClass, AliDielectronVarManager::kNMaxValues, values);
+        if(mergedtrkClass>=0 && i<2)
+          fHistos->FillClass(mergedtrkClass, AliDielectronVarManager::kNMaxValues, values); //only ev1
       }
     }
   }
 
   //Fill Pair information, separately for all pair candidate arrays and the legs
+  ResolvePairClassIndices();
   TObjArray arrLegs(100);
   for (Int_t i=0; i<10; ++i){
-    className.Form("Pair_%s",fgkPairClassNames[i]);
-    className2.Form("Track_Legs_%s",fgkPairClassNames[i]);
-    Bool_t pairClass=fHistos->GetHistogramList()->FindObject(className.Data())!=0x0;
-    Bool_t legClass=fHistos->GetHistogramList()->FindObject(className2.Data())!=0x0;
-    if (!pairClass&&!legClass) continue;
+    const Int_t pairClass=fPairClassIndex[0][i];
+    const Int_t legClass=fPairClassIndex[1][i];
+    if (pairClass<0 && legClass<0) continue;
     Int_t ntracks=PairArray(i)->GetEntriesFast();
     for (Int_t ipair=0; ipair<ntracks; ++ipair){
       AliDielectronPair *pair=static_cast<AliDielectronPair*>(PairArray(i)->UncheckedAt(ipair));
 
       //fill pair information
-      if (pairClass){
+      if (pairClass>=0){
         AliDielectronVarManager::Fill(pair, values);
-        fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
+        fHistos->FillClass(pairClass, AliDielectronVarManager::kNMaxValues, values);
       }
 
       //fill leg information, don't fill the information twice
-      if (legClass){
+      if (legClass>=0){
         AliVParticle *d1=pair->GetFirstDaughterP();
         AliVParticle *d2=pair->GetSecondDaughterP();
         if (!arrLegs.FindObject(d1)){
           AliDielectronVarManager::Fill(d1, values);
-          fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
+          fHistos->FillClass(legClass, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d1);
         }
         if (!arrLegs.FindObject(d2)){
           AliDielectronVarManager::Fill(d2, values);
-          fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
+          fHistos->FillClass(legClass, AliDielectronVarManager::kNMaxValues, values);
           arrLegs.Add(d2);
         }
       }
     }
-    if (legClass) arrLegs.Clear();
+    if (legClass>=0) arrLegs.Clear();
   }
 
 }
 
+//________________________________________________________________
+void AliDielectron::ResolvePairClassIndices()
+{
+  //
+  // Resolve the histogram class indices of the pair and leg classes of all
+  // pair types, redone only if the histogram manager or its classes changed
+  //
+  if (fHistos==fPairClassHistos && fHistos && fHistos->GetClassGeneration()==fPairClassGeneration) return;
+  static const char* kPrefix[4]={"Pair_","Track_Legs_","RejPair_","RejTrack_"};
+  TString className;
+  for (Int_t kind=0; kind<4; ++kind){
+    for (Int_t type=0; type<11; ++type){
+      className.Form("%s%s",kPrefix[kind],fgkPairClassNames[type]);
+      fPairClassIndex[kind][type]=fHistos?fHistos->GetClassIndex(className.Data()):-1;
+    }
+  }
+  fPairClassHistos=fHistos;
+  fPairClassGeneration=fHistos?fHistos->GetClassGeneration():0;
+}
+
 //________________________________________________________________
 void AliDielectron::FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFilter/*=kFALSE*/)
 {
@@ -818,38 +964,30 @@ void AliDielectron::FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFil
   //       times. This funtion is used in the track rotation pairing
   //       and those legs are not saved!
   //
-  TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues];
   AliDielectronVarManager::SetFillMap(fUsedVars);
 
   //Fill Pair information, separately for all pair candidate arrays and the legs
-  TObjArray arrLegs(100);
   const Int_t type=pair->GetType();
-  if (fromPreFilter) {
-    className.Form("RejPair_%s",fgkPairClassNames[type]);
-    className2.Form("RejTrack_%s",fgkPairClassNames[type]);
-  } else {
-    className.Form("Pair_%s",fgkPairClassNames[type]);
-    className2.Form("Track_Legs_%s",fgkPairClassNames[type]);
-  }
-
-  Bool_t pairClass=fHistos->GetHistogramList()->FindObject(className.Data())!=0x0;
-  Bool_t legClass=fHistos->GetHistogramList()->FindObject(className2.Data())!=0x0;
+  if (type<0 || type>10) return;
+  ResolvePairClassIndices();
+  const Int_t pairClass=fPairClassIndex[fromPreFilter?2:0][type];
+  const Int_t legClass=fPairClassIndex[fromPreFilter?3:1][type];
 
   //fill pair information
-  if (pairClass){
+  if (pairClass>=0){
     AliDielectronVarManager::Fill(pair, values);
-    fHistos->FillClass(className, AliDielectronVarManager::kNMaxValues, values);
+    fHistos->FillClass(pairClass, AliDielectronVarManager::kNMaxValues, values);
   }
 
-  if (legClass){
+  if (legClass>=0){
     AliVParticle *d1=pair->GetFirstDaughterP();
     AliDielectronVarManager::Fill(d1, values);
-    fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
+    fHistos->FillClass(legClass, AliDielectronVarManager::kNMaxValues, values);
 
     AliVParticle *d2=pair->GetSecondDaughterP();
     AliDielectronVarManager::Fill(d2, values);
-    fHistos->FillClass(className2, AliDielectronVarManager::kNMaxValues, values);
+    fHistos->FillClass(legClass, AliDielectronVarManager::kNMaxValues, values);
   }
 }
 
@@ -942,12 +1080,26 @@ void AliDielectron::EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTra
     AliDielectronPair candidate;
     candidate.SetKFUsage(fUseKF);
 
+    // only pairs inside the (eta, phi) neighbourhood can be rejected
+    AliDielectronLegIndex *legIndex=0x0;
+    Int_t *partners=0x0;
+    if (fEventPlanePreFilterDeltaEta>0. && fEventPlanePreFilterDeltaPhi>0.) {
+      legIndex=new AliDielectronLegIndex(arrTracks2, fEventPlanePreFilterDeltaEta, fEventPlanePreFilterDeltaPhi);
+      partners=new Int_t[ntrack2+1];
+    }
+
     UInt_t selectedMask=(1<<fEventPlanePOIPreFilter.GetCuts()->GetEntries())-1;
     for (Int_t itrack1=0; itrack1<ntrack1; ++itrack1){
       Int_t end=ntrack2;
       if (arr1==arr2) end=itrack1;
+      Int_t npartners=end;
+      if (legIndex) {
+        const AliVParticle *leg1=static_cast<const AliVParticle*>(arrTracks1.UncheckedAt(itrack1));
+        npartners = leg1 ? legIndex->GetPartners(leg1, end, partners) : 0;
+      }
       Bool_t accepted=kFALSE;
-      for (Int_t itrack2=0; itrack2<end; ++itrack2){
+      for (Int_t ipartner=0; ipartner<npartners; ++ipartner){
+        const Int_t itrack2 = legIndex ? partners[ipartner] : ipartner;
         TObject *track1=arrTracks1.UncheckedAt(itrack1);
         TObject *track2=arrTracks2.UncheckedAt(itrack2);
         if (!track1 || !track2) continue;
@@ -968,6 +1120,8 @@ void AliDielectron::EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTra
       }
       if ( accepted ) arrTracks1.AddAt(0x0,itrack1);
     }
+    delete legIndex;
+    delete [] partners;
     //compress the track arrays
     arrTracks1.Compress();
     arrTracks2.Compress();
@@ -1107,12 +1261,26 @@ void AliDielectron::EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTra
     AliDielectronPair candidate;
     candidate.SetKFUsage(fUseKF);
 
+    // only pairs inside the (eta, phi) neighbourhood can be rejected
+    AliDielectronLegIndex *legIndex=0x0;
+    Int_t *partners=0x0;
+    if (fEventPlanePreFilterDeltaEta>0. && fEventPlanePreFilterDeltaPhi>0.) {
+      legIndex=new AliDielectronLegIndex(arrTracks2, fEventPlanePreFilterDeltaEta, fEventPlanePreFilterDeltaPhi);
+      partners=new Int_t[ntrack2+1];
+    }
+
     UInt_t selectedMask=(1<<fEventPlanePOIPreFilter.GetCuts()->GetEntries())-1;
     for (Int_t itrack1=0; itrack1<ntrack1; ++itrack1){
       Int_t end=ntrack2;
       if (arr1==arr2) end=itrack1;
+      Int_t npartners=end;
+      if (legIndex) {
+        const AliVParticle *leg1=static_cast<const AliVParticle*>(arrTracks1.UncheckedAt(itrack1));
+        npartners = leg1 ? legIndex->GetPartners(leg1, end, partners) : 0;
+      }
       Bool_t accepted=kFALSE;
-      for (Int_t itrack2=0; itrack2<end; ++itrack2){
+      for (Int_t ipartner=0; ipartner<npartners; ++ipartner){
+        const Int_t itrack2 = legIndex ? partners[ipartner] : ipartner;
         TObject *track1=arrTracks1.UncheckedAt(itrack1);
         TObject *track2=arrTracks2.UncheckedAt(itrack2);
         if (!track1 || !track2) continue;
@@ -1134,6 +1302,8 @@ void AliDielectron::EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTra
       }
       if ( accepted ) arrTracks1.AddAt(0x0,itrack1);
     }
+    delete legIndex;
+    delete [] partners;
     //compress the track arrays
     arrTracks1.Compress();
     arrTracks2.Compress();
@@ -1299,10 +1469,23 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
       }
     }
     else{
+      // only pairs inside the (eta, phi) neighbourhood can be rejected
+      AliDielectronLegIndex *legIndex=0x0;
+      Int_t *partners=0x0;
+      if (fPreFilterDeltaEta>0. && fPreFilterDeltaPhi>0.) {
+        legIndex=new AliDielectronLegIndex(*arrTracks2RP, fPreFilterDeltaEta, fPreFilterDeltaPhi);
+        partners=new Int_t[ntrack2RP+1];
+      }
       for (Int_t itrack1=0; itrack1<ntrack1RP; ++itrack1){
         Int_t end=ntrack2RP;
         if (arr1RP==arr2RP) end=itrack1;
-        for (Int_t itrack2=0; itrack2<end; ++itrack2){
+        Int_t npartners=end;
+        if (legIndex) {
+          const AliVParticle *leg1=static_cast<const AliVParticle*>((*arrTracks1RP).UncheckedAt(itrack1));
+          npartners = leg1 ? legIndex->GetPartners(leg1, end, partners) : 0;
+        }
+        for (Int_t ipartner=0; ipartner<npartners; ++ipartner){
+          const Int_t itrack2 = legIndex ? partners[ipartner] : ipartner;
           TObject *track1=(*arrTracks1RP).UncheckedAt(itrack1);
           TObject *track2=(*arrTracks2RP).UncheckedAt(itrack2);
           if (!track1 || !track2) continue;
@@ -1333,6 +1516,8 @@ void AliDielectron::PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1,
           bTracks2RP[itrack2]=kTRUE;
         }
       }
+      delete legIndex;
+      delete [] partners;
     }
   }
 
@@ -1415,7 +1600,7 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
-  AliDielectronPair *candidate=new AliDielectronPair;
+  AliDielectronPair *candidate=NewPairCandidate();
   candidate->SetKFUsage(fUseKF);
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
@@ -1463,12 +1648,40 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       //add the candidate to the candidate array
       PairArray(pairIndex)->Add(candidate);
       //get a new candidate
-      candidate=new AliDielectronPair;
+      candidate=NewPairCandidate();
       candidate->SetKFUsage(fUseKF);
     }
   }
-  //delete the surplus candidate
-  delete candidate;
+  //release the surplus candidate
+  ReleasePairCandidate(candidate);
+}
+
+//________________________________________________________________
+AliDielectronPair* AliDielectron::NewPairCandidate()
+{
+  //
+  // get a pair candidate, recycled from the pool if requested
+  // pool candidates keep the state of their previous use
+  //
+  if (!fUsePairPool) return new AliDielectronPair;
+
+  AliDielectronPair *pair=static_cast<AliDielectronPair*>(fPairPool.ConstructedAt(fNPairPool));
+  ++fNPairPool;
+  if (fNPairPool>fPairPoolHighWater) fPairPoolHighWater=fNPairPool;
+  return pair;
+}
+
+//________________________________________________________________
+void AliDielectron::ReleasePairCandidate(AliDielectronPair *pair)
+{
+  //
+  // give back the last candidate obtained from NewPairCandidate
+  //
+  if (!fUsePairPool) {
+    delete pair;
+    return;
+  }
+  if (fNPairPool>0 && fPairPool.UncheckedAt(fNPairPool-1)==pair) --fNPairPool;
 }
 
 //________________________________________________________________
@@ -1500,7 +1713,11 @@ void AliDielectron::FillPairArrayTR()
       if (fHistoArray) fHistoArray->Fill((Int_t)kEv1PMRot,&candidate);
 
       if(fHistos) FillHistogramsPair(&candidate);
-      if(fStoreRotatedPairs) PairArray(kEv1PMRot)->Add(new AliDielectronPair(candidate));
+      if(fStoreRotatedPairs) {
+        AliDielectronPair *stored=NewPairCandidate();
+        *stored=candidate;
+        PairArray(kEv1PMRot)->Add(stored);
+      }
     }
   }
 }
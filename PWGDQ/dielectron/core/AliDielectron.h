@@ -18,6 +18,7 @@
 
 #include <TNamed.h>
 #include <TObjArray.h>
+#include <TClonesArray.h>
 #include <THnBase.h>
 #include <TSpline.h>
 
@@ -127,6 +128,13 @@ public:
   void SetPreFilterPhotons2(Bool_t setValue=kTRUE){fPreFilterPhotons2=setValue;};
   void SetPreFilterOnlyOnePair2(Bool_t setValue=kTRUE){fPreFilterOnlyOnePair2=setValue;};
 
+  // Only build prefilter pairs of legs inside |deta|<=dEta and |dphi|<=dPhi.
+  // The neighbourhood must contain all pairs the prefilter cuts can reject,
+  // then the result is identical to the full pair loop. Not used with
+  // SetPreFilterOnlyOnePair. dEta or dPhi <= 0 switches it off (default)
+  void SetPreFilterNeighborhood(Double_t dEta, Double_t dPhi) { fPreFilterDeltaEta=dEta; fPreFilterDeltaPhi=dPhi; }
+  void SetEventPlanePreFilterNeighborhood(Double_t dEta, Double_t dPhi) { fEventPlanePreFilterDeltaEta=dEta; fEventPlanePreFilterDeltaPhi=dPhi; }
+
   void SetTrackRotator(AliDielectronTrackRotator * const rot) { fTrackRotator=rot; }
   AliDielectronTrackRotator* GetTrackRotator() const { return fTrackRotator; }
 
@@ -148,6 +156,13 @@ public:
   void SetDontClearArrays(Bool_t dontClearArrays=kTRUE) { fDontClearArrays=dontClearArrays; }
   Bool_t DontClearArrays() const { return fDontClearArrays; }
 
+  // recycle pair candidates (same event, rotated and mixed) from a per instance pool
+  // which is reset once per event, instead of allocating them. To be set before Init()
+  void SetUsePairPool(Bool_t usePool=kTRUE) { fUsePairPool=usePool; }
+  Bool_t GetUsePairPool() const             { return fUsePairPool; }
+  Int_t GetPairPoolSize() const             { return fPairPool.GetEntriesFast(); }
+  Int_t GetPairPoolHighWaterMark() const    { return fPairPoolHighWater; }
+
   void AddSignalMC(AliDielectronSignalMC* signal);
 
   void SetDebugTree(AliDielectronDebugTree * const tree) { fDebugTree=tree; }
@@ -273,6 +288,17 @@ private:
   Bool_t fDontClearArrays;      //Don't clear the arrays at the end of the Process function, needed for external use of pair and tracks
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
+  Double_t fPreFilterDeltaEta;  // eta half width of the pair prefilter neighbourhood, <=0: all pairs
+  Double_t fPreFilterDeltaPhi;  // phi half width of the pair prefilter neighbourhood, <=0: all pairs
+  Double_t fEventPlanePreFilterDeltaEta;  // eta half width of the event plane POI prefilter neighbourhood
+  Double_t fEventPlanePreFilterDeltaPhi;  // phi half width of the event plane POI prefilter neighbourhood
+  Bool_t fUsePairPool;          // take pair candidates from fPairPool
+  TClonesArray fPairPool;       //! recycled pair candidates, owner of all pairs in the pair arrays if fUsePairPool
+  Int_t fNPairPool;             //! pair candidates taken from the pool in the current event
+  Int_t fPairPoolHighWater;     //! maximum number of pool candidates used in one event
+  Int_t fPairClassIndex[4][11]; //! histogram class index of Pair_, Track_Legs_, RejPair_, RejTrack_ per pair type
+  AliDielectronHistos *fPairClassHistos; //! histogram manager fPairClassIndex was resolved for
+  UInt_t fPairClassGeneration;  //! class generation of fPairClassHistos fPairClassIndex was resolved for
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
@@ -285,6 +311,9 @@ private:
   void InitPairCandidateArrays();
   void ClearArrays();
 
+  AliDielectronPair* NewPairCandidate();
+  void ReleasePairCandidate(AliDielectronPair *pair);
+
   TObjArray* PairArray(Int_t i);
   TObject* InitEffMap(TString filename, TString generatedname, TString foundname);
 
@@ -305,6 +334,7 @@ private:
   void  FillMCHistograms(Int_t label1, Int_t label2, Int_t nSignal);
   void  FillHistogramsMC(const AliMCEvent *ev,  AliVEvent *ev1);
   void  FillHistogramsPair(AliDielectronPair *pair,Bool_t fromPreFilter=kFALSE);
+  void  ResolvePairClassIndices();
   void  FillHistogramsTracks(TObjArray **tracks);
 
   void  FillDebugTree();
@@ -312,7 +342,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,20);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -324,7 +354,8 @@ inline void AliDielectron::InitPairCandidateArrays()
   for (Int_t i=0;i<11;++i){
     TObjArray *arr=new TObjArray;
     fPairCandidates->AddAt(arr,i);
-    arr->SetOwner();
+    // pool pairs are owned by the pool
+    arr->SetOwner(!fUsePairPool);
   }
 }
 
@@ -345,8 +376,12 @@ inline void AliDielectron::ClearArrays()
     fTracks[i].Clear();
   }
   for (Int_t i=0;i<11;++i){
-    if (PairArray(i)) PairArray(i)->Delete();
+    if (!PairArray(i)) continue;
+    if (fUsePairPool) PairArray(i)->Clear();
+    else PairArray(i)->Delete();
   }
+  // all pool candidates are free again
+  fNPairPool=0;
 }
 
 #endif
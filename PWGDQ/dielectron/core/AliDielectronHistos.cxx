@@ -61,7 +61,17 @@ AliDielectronHistos::AliDielectronHistos() :
   fHistoList(),
   fList(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
-  fReservedWords(new TString)
+  fReservedWords(new TString),
+  fFillPlanValid(kFALSE),
+  fClassGeneration(0),
+  fNFillClasses(0),
+  fFillClassTable(0x0),
+  fFillClassFirst(0x0),
+  fNFillRecords(0),
+  fFillHist(0x0),
+  fFillKind(0x0),
+  fFillDim(0x0),
+  fFillVars(0x0)
 {
   //
   // Default constructor
@@ -77,7 +87,17 @@ AliDielectronHistos::AliDielectronHistos(const char* name, const char* title) :
   fHistoList(),
   fList(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
-  fReservedWords(new TString)
+  fReservedWords(new TString),
+  fFillPlanValid(kFALSE),
+  fClassGeneration(0),
+  fNFillClasses(0),
+  fFillClassTable(0x0),
+  fFillClassFirst(0x0),
+  fNFillRecords(0),
+  fFillHist(0x0),
+  fFillKind(0x0),
+  fFillDim(0x0),
+  fFillVars(0x0)
 {
   //
   // TNamed constructor
@@ -96,6 +116,7 @@ AliDielectronHistos::~AliDielectronHistos()
   if (fUsedVars) delete fUsedVars;
   if (fList) fList->Clear();
   delete fReservedWords;
+  ClearFillPlan();
 }
 
 //_____________________________________________________________________________
@@ -625,6 +646,7 @@ void AliDielectronHistos::UserHistogram(const char* histClass, TObject* hist, UI
   }
 
   classTable->Add(hist);
+  fFillPlanValid=kFALSE;
 }
 
 //_____________________________________________________________________________
@@ -651,6 +673,8 @@ void AliDielectronHistos::AddClass(const char* histClass)
     table->SetOwner(kTRUE);
     table->SetName(o->GetName());
     fHistoList.Add(table);
+    fFillPlanValid=kFALSE;
+    ++fClassGeneration;
   }
   delete arr;
 }
@@ -707,17 +731,210 @@ void AliDielectronHistos::FillClass(const char* histClass, Int_t nValues, const
   // Fill class 'histClass' (by name)
   //
 
-  THashList *classTable=(THashList*)fHistoList.FindObject(histClass);
-  if (!classTable){
+  const Int_t classIndex=GetClassIndex(histClass);
+  if (classIndex<0){
     Warning("FillClass","Cannot fill class '%s' its not defined. nValues %d",histClass,nValues);
     return;
   }
 
-  TIter nextHist(classTable);
-  TObject *obj=0;
-  while ( (obj=(TObject*)nextHist()) )  FillValues(obj, values);
+  FillClass(classIndex, nValues, values);
+}
 
-  return;
+//_____________________________________________________________________________
+void AliDielectronHistos::FillClass(Int_t classIndex, Int_t /*nValues*/, const Double_t *values)
+{
+  //
+  // Fill class by index, see GetClassIndex
+  //
+  if (!fFillPlanValid) Compile();
+  if (classIndex<0 || classIndex>=fNFillClasses) return;
+
+  const Int_t last=fFillClassFirst[classIndex+1];
+  for (Int_t irec=fFillClassFirst[classIndex]; irec<last; ++irec) FillRecord(irec, values);
+}
+
+//_____________________________________________________________________________
+Int_t AliDielectronHistos::GetClassIndex(const char* histClass)
+{
+  //
+  // index of class 'histClass' in the compiled fill plan, -1 if it does not exist
+  // the index stays valid as long as no class is removed, callers caching it can
+  // check GetClassGeneration(), which changes whenever classes are added or removed
+  //
+  if (!fFillPlanValid) Compile();
+
+  TObject *classTable=fHistoList.FindObject(histClass);
+  if (!classTable) return -1;
+
+  // the class index is cached in the unique ID of the class table
+  const Int_t cached=(Int_t)classTable->GetUniqueID();
+  if (cached<fNFillClasses && fFillClassTable[cached]==classTable) return cached;
+  for (Int_t iclass=0; iclass<fNFillClasses; ++iclass) {
+    if (fFillClassTable[iclass]==classTable) return iclass;
+  }
+  return -1;
+}
+
+//_____________________________________________________________________________
+void AliDielectronHistos::Compile()
+{
+  //
+  // Resolve all histogram classes into a flat list of fill records
+  // (histogram, variables, fill kind), such that filling a class does
+  // not need any lookup or type check. Called automatically by FillClass
+  // whenever histograms or classes were added
+  //
+  ClearFillPlan();
+
+  Int_t nHists=0;
+  TIter nextClass(&fHistoList);
+  TObject *o=0x0;
+  while ( (o=nextClass()) ) {
+    if (o->InheritsFrom(TCollection::Class())) nHists+=static_cast<TCollection*>(o)->GetEntries();
+  }
+
+  fNFillClasses=fHistoList.GetEntries();
+  fFillClassTable=new TObject*[fNFillClasses+1];
+  fFillClassFirst=new Int_t[fNFillClasses+1];
+  fFillHist=new TObject*[nHists+1];
+  fFillKind=new UChar_t[nHists+1];
+  fFillDim=new UChar_t[nHists+1];
+  fFillVars=new UInt_t[kMaxFillVars*(nHists+1)];
+
+  Int_t iclass=0;
+  nextClass.Reset();
+  while ( (o=nextClass()) ) {
+    fFillClassTable[iclass]=o;
+    fFillClassFirst[iclass]=fNFillRecords;
+    o->SetUniqueID(iclass);
+    if (o->InheritsFrom(TCollection::Class())) {
+      TIter nextHist(static_cast<TCollection*>(o));
+      TObject *obj=0x0;
+      while ( (obj=nextHist()) ) fNFillRecords+=AddFillRecord(obj, fNFillRecords);
+    }
+    ++iclass;
+  }
+  fFillClassFirst[fNFillClasses]=fNFillRecords;
+  fFillPlanValid=kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliDielectronHistos::ClearFillPlan()
+{
+  //
+  // release the compiled fill plan
+  //
+  delete [] fFillClassTable;
+  delete [] fFillClassFirst;
+  delete [] fFillHist;
+  delete [] fFillKind;
+  delete [] fFillDim;
+  delete [] fFillVars;
+  fFillClassTable=0x0;
+  fFillClassFirst=0x0;
+  fFillHist=0x0;
+  fFillKind=0x0;
+  fFillDim=0x0;
+  fFillVars=0x0;
+  fNFillClasses=0;
+  fNFillRecords=0;
+  fFillPlanValid=kFALSE;
+}
+
+//_____________________________________________________________________________
+Int_t AliDielectronHistos::AddFillRecord(TObject *obj, Int_t irec)
+{
+  //
+  // compile the fill record irec for obj, following FillValues
+  // returns the number of added records
+  //
+  if (!obj) return 0;
+
+  const UInt_t valueTypes=obj->GetUniqueID();
+  if (valueTypes==(UInt_t)AliDielectronHistos::kNoAutoFill) return 0;
+  Bool_t weight = (valueTypes!=kNoWeights);
+
+  UInt_t *vars=fFillVars+kMaxFillVars*irec;
+  for (Int_t i=0; i<kMaxFillVars; ++i) vars[i]=0;
+  vars[kMaxFillVars-1]=valueTypes;   // weight, or profile variable of TProfile3D
+
+  UChar_t kind=kFillGeneric;
+  Int_t dim=0;
+  if (obj->InheritsFrom(TH1::Class())) {
+    TH1 *hist=static_cast<TH1*>(obj);
+    dim=hist->GetDimension();
+    vars[0]=hist->GetXaxis()->GetUniqueID();
+    vars[1]=hist->GetYaxis()->GetUniqueID();
+    vars[2]=hist->GetZaxis()->GetUniqueID();
+
+    const Bool_t bprf=(obj->IsA() == TProfile::Class() || obj->IsA() == TProfile2D::Class() || obj->IsA() == TProfile3D::Class());
+    if (obj->IsA() == TProfile3D::Class()) weight=kFALSE;
+
+    // inclusive trigger map variables are filled by FillValues
+    Bool_t trigger=kFALSE;
+    for (Int_t i=0; i<3; ++i)
+      trigger|=(vars[i]==AliDielectronVarManager::kTriggerInclONL || vars[i]==AliDielectronVarManager::kTriggerInclOFF);
+    trigger|=(valueTypes==AliDielectronVarManager::kTriggerInclONL || valueTypes==AliDielectronVarManager::kTriggerInclOFF);
+
+    if (!trigger) {
+      switch ( dim ) {
+      case 1: kind = bprf ? (weight ? kFillP1W : kFillP1) : (weight ? kFillH1W : kFillH1); break;
+      case 2: kind = bprf ? (weight ? kFillP2W : kFillP2) : (weight ? kFillH2W : kFillH2); break;
+      case 3: kind = bprf ? kFillP3 : (weight ? kFillH3W : kFillH3); break;
+      }
+    }
+  }
+  else if (obj->InheritsFrom(THnBase::Class())) {
+    THnBase *hist=static_cast<THnBase*>(obj);
+    dim=hist->GetNdimensions();
+    if (dim<kMaxFillVars) {
+      for (Int_t it=0; it<dim; ++it) vars[it]=hist->GetAxis(it)->GetUniqueID();
+      kind = weight ? kFillHnW : kFillHn;
+    }
+  }
+  else {
+    return 0;
+  }
+
+  fFillHist[irec]=obj;
+  fFillKind[irec]=kind;
+  fFillDim[irec]=(UChar_t)dim;
+  return 1;
+}
+
+//_____________________________________________________________________________
+void AliDielectronHistos::FillRecord(Int_t irec, const Double_t *values)
+{
+  //
+  // fill the histogram of the compiled record irec
+  //
+  const UInt_t *v=fFillVars+kMaxFillVars*irec;
+  const UInt_t  w=v[kMaxFillVars-1];   // weight or profile variable
+  TObject *obj=fFillHist[irec];
+
+  switch ( fFillKind[irec] ) {
+  case kFillH1:  static_cast<TH1*>(obj)->Fill(values[v[0]]); break;
+  case kFillH1W: static_cast<TH1*>(obj)->Fill(values[v[0]], values[w]); break;
+  case kFillP1:  static_cast<TProfile*>(obj)->Fill(values[v[0]], values[v[1]]); break;
+  case kFillP1W: static_cast<TProfile*>(obj)->Fill(values[v[0]], values[v[1]], values[w]); break;
+  case kFillH2:  static_cast<TH1*>(obj)->Fill(values[v[0]], values[v[1]]); break;
+  case kFillH2W: static_cast<TH2*>(obj)->Fill(values[v[0]], values[v[1]], values[w]); break;
+  case kFillP2:  static_cast<TProfile2D*>(obj)->Fill(values[v[0]], values[v[1]], values[v[2]]); break;
+  case kFillP2W: static_cast<TProfile2D*>(obj)->Fill(values[v[0]], values[v[1]], values[v[2]], values[w]); break;
+  case kFillH3:  static_cast<TH3*>(obj)->Fill(values[v[0]], values[v[1]], values[v[2]]); break;
+  case kFillH3W: static_cast<TH3*>(obj)->Fill(values[v[0]], values[v[1]], values[v[2]], values[w]); break;
+  case kFillP3:  static_cast<TProfile3D*>(obj)->Fill(values[v[0]], values[v[1]], values[v[2]], values[w]); break;
+  case kFillHn:
+  case kFillHnW: {
+    Double_t fill[kMaxFillVars];
+    const Int_t dim=fFillDim[irec];
+    for (Int_t it=0; it<dim; ++it) fill[it]=values[v[it]];
+    if (fFillKind[irec]==kFillHn) static_cast<THnBase*>(obj)->Fill(fill);
+    else                          static_cast<THnBase*>(obj)->Fill(fill, values[w]);
+    break;
+  }
+  default: FillValues(obj, values); break;
+  }
 }
 
 //_____________________________________________________________________________
@@ -974,6 +1191,7 @@ void AliDielectronHistos::SetHistogramList(THashList &list, Bool_t setOwner/*=kT
   while ( (o=next()) ){
     fHistoList.Add(o);
   }
+  ++fClassGeneration;
   if (setOwner){
     list.SetOwner(kFALSE);
     fHistoList.SetOwner(kTRUE);
@@ -145,6 +145,12 @@ public:
   
 //   void FillClass(const char* histClass, const TVectorD &vals);
   void FillClass(const char* histClass, Int_t nValues, const Double_t *values);
+  void FillClass(Int_t classIndex, Int_t nValues, const Double_t *values);
+
+  // compiled fill plan: flat list of (histogram, variables, fill kind) per class
+  void Compile();
+  Int_t GetClassIndex(const char* histClass);
+  UInt_t GetClassGeneration() const { return fClassGeneration; }
   
   TObject* GetHist(const char* histClass, const char* name) const;
   TH1* GetHistogram(const char* histClass, const char* name) const;
@@ -152,7 +158,7 @@ public:
   TH1* GetHistogram(const char* cutClass, const char* histClass, const char* name) const;
 
   void SetHistogramList(THashList &list, Bool_t setOwner=kTRUE);
-  void ResetHistogramList(){fHistoList.Clear();}
+  void ResetHistogramList(){fHistoList.Clear(); fFillPlanValid=kFALSE; ++fClassGeneration;}
   const THashList* GetHistogramList() const {return &fHistoList;}
 
   void SetList(TList * const list) { fList=list; }
@@ -189,13 +195,33 @@ public:
 
 private:
 
+  enum EFillKind { kFillH1=0, kFillH1W, kFillP1, kFillP1W,
+                   kFillH2, kFillH2W, kFillP2, kFillP2W,
+                   kFillH3, kFillH3W, kFillP3,
+                   kFillHn, kFillHnW, kFillGeneric };
+  enum { kMaxFillVars=20 };
+
   void FillVarArray(TObject *obj, UInt_t *valType);
+  void ClearFillPlan();
+  Int_t AddFillRecord(TObject *obj, Int_t irec);
+  void FillRecord(Int_t irec, const Double_t *values);
 
   THashList fHistoList;             //-> list of histograms
   TList    *fList;                  //! List of list of histograms
 	TBits     *fUsedVars;            // list of used variables
 
   TString *fReservedWords;          //! list of reserved words
+
+  Bool_t    fFillPlanValid;         //! if the compiled fill plan matches fHistoList
+  UInt_t    fClassGeneration;       //! incremented whenever classes are added or removed
+  Int_t     fNFillClasses;          //! number of compiled classes
+  TObject **fFillClassTable;        //! [fNFillClasses] class table of each compiled class
+  Int_t    *fFillClassFirst;        //! [fNFillClasses+1] first fill record of each class
+  Int_t     fNFillRecords;          //! number of compiled fill records
+  TObject **fFillHist;              //! [fNFillRecords] histogram of each record
+  UChar_t  *fFillKind;              //! [fNFillRecords] EFillKind of each record
+  UChar_t  *fFillDim;               //! [fNFillRecords] number of axes of each record
+  UInt_t   *fFillVars;              //! [kMaxFillVars*fNFillRecords] axis variables, weight/profile variable at kMaxFillVars-1
   void UserHistogramReservedWords(const char* histClass, const TObject *hist, UInt_t valTypes);
   void FillClass(THashTable *classTable, Int_t nValues, Double_t *values);
   
@@ -208,7 +234,7 @@ private:
   AliDielectronHistos(const AliDielectronHistos &hist);
   AliDielectronHistos& operator = (const AliDielectronHistos &hist);
 
-  ClassDef(AliDielectronHistos,3)
+  ClassDef(AliDielectronHistos,4)
 };
 
 #endif
@@ -356,6 +356,9 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fEnableSortForClusMC(kFALSE),
   fDoPrimaryTrackMatching(kFALSE),
   fDoInvMassShowerShapeTree(kFALSE),
+  fDoSharedMesonPairs(kFALSE),
+  fMesonPairCache(NULL),
+  fGammaReaderIndex(),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL)
 {
@@ -658,6 +661,9 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fEnableSortForClusMC(kFALSE),
   fDoPrimaryTrackMatching(kFALSE),
   fDoInvMassShowerShapeTree(kFALSE),
+  fDoSharedMesonPairs(kFALSE),
+  fMesonPairCache(NULL),
+  fGammaReaderIndex(),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL)
 {
@@ -691,6 +697,10 @@ AliAnalysisTaskGammaConvCalo::~AliAnalysisTaskGammaConvCalo()
     delete[] fBGClusHandlerRP;
     fBGClusHandlerRP = 0x0;
   }
+  if(fMesonPairCache){
+    delete fMesonPairCache;
+    fMesonPairCache = 0x0;
+  }
 }
 //___________________________________________________________
 void AliAnalysisTaskGammaConvCalo::InitBack(){
@@ -808,6 +818,9 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
   fClusterCandidates  = new TList();
   fClusterCandidates->SetOwner(kTRUE);
 
+  // Meson candidates shared by all cut sets, only useful with more than one cut set
+  if(fDoSharedMesonPairs && fDoMesonAnalysis && fnCuts > 1) fMesonPairCache = new AliConversionMesonPairCache();
+
   fCutFolder          = new TList*[fnCuts];
   fESDList            = new TList*[fnCuts];
 
@@ -2386,6 +2399,7 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  if(fMesonPairCache) fMesonPairCache->NewEvent(fReaderGammas->GetEntriesFast(),fInputEvent->GetNumberOfCaloClusters());
 
   // ------------------- BeginEvent ----------------------------
   AliEventplane *EventPlane = fInputEvent->GetEventplane();
@@ -3969,6 +3983,7 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
 
   // Conversion Gammas
   if(fGammaCandidates->GetEntries()>0){
+    if(fMesonPairCache) FindReaderIndices();
     for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries();firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
@@ -3998,7 +4013,12 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
           }
         }
 
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+        // shared candidates are owned by the cache, the pair only depends on the two photons
+        AliAODConversionMother *pi0cand = NULL;
+        if(fMesonPairCache && fGammaReaderIndex[firstGammaIndex] >= 0 && gamma1->GetIsCaloPhoton())
+          pi0cand = fMesonPairCache->GetPair(fGammaReaderIndex[firstGammaIndex],gamma1->GetCaloClusterRef(),gamma0,gamma1);
+        Bool_t ownPi0cand = (pi0cand == NULL);
+        if(ownPi0cand) pi0cand = new AliAODConversionMother(gamma0,gamma1);
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
 
         if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
@@ -4150,12 +4170,32 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
             }
           }
         }
-        delete pi0cand;
+        if(ownPi0cand) delete pi0cand;
         pi0cand=0x0;
       }
     }
   }
 }
+//______________________________________________________________________
+void AliAnalysisTaskGammaConvCalo::FindReaderIndices(){
+  // Position of each of the current cut's conversion gammas in the V0 reader
+  // array, used as key of the shared meson candidates. The gammas are
+  // selected in the order of the reader array, so a single pass is enough;
+  // -1 if a gamma is not found (its pairs are then built privately)
+  Int_t nGammas = fGammaCandidates->GetEntries();
+  Int_t nReaderGammas = fReaderGammas->GetEntriesFast();
+  fGammaReaderIndex.assign(nGammas,-1);
+  TIter nextGamma(fGammaCandidates);
+  TObject *gamma = NULL;
+  Int_t iGamma = 0;
+  Int_t iReader = 0;
+  while((gamma = nextGamma())){
+    while(iReader < nReaderGammas && fReaderGammas->At(iReader) != gamma) iReader++;
+    if(iReader == nReaderGammas) break;
+    fGammaReaderIndex[iGamma++] = iReader++;
+  }
+}
+
 //______________________________________________________________________
 void AliAnalysisTaskGammaConvCalo::ProcessTrueMesonCandidates(AliAODConversionMother *Pi0Candidate, AliAODConversionPhoton *TrueGammaCandidate0, AliAODConversionPhoton *TrueGammaCandidate1, Bool_t matched)
 {
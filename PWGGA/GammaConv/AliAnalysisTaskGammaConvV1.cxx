@@ -263,6 +263,9 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
+  fDoSharedMesonPairs(kFALSE),
+  fMesonPairCache(NULL),
+  fGammaReaderIndex(),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL)
 {
@@ -473,6 +476,9 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
   fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
+  fDoSharedMesonPairs(kFALSE),
+  fMesonPairCache(NULL),
+  fGammaReaderIndex(),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL)
 {
@@ -499,6 +505,10 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete[] fWeightCentrality;
     fWeightCentrality = 0x0;
   }
+  if(fMesonPairCache){
+    delete fMesonPairCache;
+    fMesonPairCache = 0x0;
+  }
 
 }
 //___________________________________________________________
@@ -609,6 +619,9 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
   // Array of current cut's gammas
   fGammaCandidates          = new TList();
 
+  // Meson candidates shared by all cut sets, only useful with more than one cut set
+  if(fDoSharedMesonPairs && fDoMesonAnalysis && fnCuts > 1) fMesonPairCache = new AliConversionMesonPairCache();
+
   fCutFolder                = new TList*[fnCuts];
   fESDList                  = new TList*[fnCuts];
   if(fDoTHnSparse){
@@ -1671,6 +1684,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  if(fMesonPairCache) fMesonPairCache->NewEvent(fReaderGammas->GetEntriesFast(),fReaderGammas->GetEntriesFast());
 
   // ------------------- BeginEvent ----------------------------
 
@@ -2936,6 +2950,7 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
 
   // Conversion Gammas
   if(fGammaCandidates->GetEntries()>1){
+    if(fMesonPairCache) FindReaderIndices();
     for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries()-1;firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
@@ -2948,9 +2963,16 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
         gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelPositive() ||
         gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelNegative() ) continue;
 
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+        // shared candidates are owned by the cache, the pair only depends on the two photons
+        AliAODConversionMother *pi0cand = NULL;
+        if(fMesonPairCache && fGammaReaderIndex[firstGammaIndex] >= 0 && fGammaReaderIndex[secondGammaIndex] >= 0)
+          pi0cand = fMesonPairCache->GetPair(fGammaReaderIndex[firstGammaIndex],fGammaReaderIndex[secondGammaIndex],gamma0,gamma1,fInputEvent->GetPrimaryVertex());
+        Bool_t ownPi0cand = (pi0cand == NULL);
+        if(ownPi0cand){
+          pi0cand = new AliAODConversionMother(gamma0,gamma1);
+          pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+        }
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
-        pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
 
         if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
           if(fDoCentralityFlat > 0){
@@ -3048,13 +3070,33 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
             }
           }
         }
-        delete pi0cand;
+        if(ownPi0cand) delete pi0cand;
         pi0cand=0x0;
       }
     }
   }
 }
 
+//______________________________________________________________________
+void AliAnalysisTaskGammaConvV1::FindReaderIndices(){
+  // Position of each of the current cut's gammas in the V0 reader array,
+  // used as key of the shared meson candidates. The gammas are selected
+  // in the order of the reader array, so a single pass is enough; -1 if
+  // a gamma is not found (its pairs are then built privately)
+  Int_t nGammas = fGammaCandidates->GetEntries();
+  Int_t nReaderGammas = fReaderGammas->GetEntriesFast();
+  fGammaReaderIndex.assign(nGammas,-1);
+  TIter nextGamma(fGammaCandidates);
+  TObject *gamma = NULL;
+  Int_t iGamma = 0;
+  Int_t iReader = 0;
+  while((gamma = nextGamma())){
+    while(iReader < nReaderGammas && fReaderGammas->At(iReader) != gamma) iReader++;
+    if(iReader == nReaderGammas) break;
+    fGammaReaderIndex[iGamma++] = iReader++;
+  }
+}
+
 //______________________________________________________________________
 void AliAnalysisTaskGammaConvV1::ProcessTrueMesonCandidates(AliAODConversionMother *Pi0Candidate, AliAODConversionPhoton *TrueGammaCandidate0, AliAODConversionPhoton *TrueGammaCandidate1)
 {
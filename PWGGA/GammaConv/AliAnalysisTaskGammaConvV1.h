@@ -10,6 +10,7 @@
 #include "AliGammaConversionAODBGHandler.h"
 #include "AliConversionAODBGHandlerRP.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionMesonPairCache.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -43,9 +44,11 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void SetDoPlotVsCentrality(Bool_t flag)                       { fDoPlotVsCentrality         = flag    ;}
     void SetDoTHnSparse(Bool_t flag)                              { fDoTHnSparse                = flag    ;}
     void SetDoCentFlattening(Int_t flag)                          { fDoCentralityFlat           = flag    ;}
+    void SetDoSharedMesonPairs(Bool_t flag)                       { fDoSharedMesonPairs         = flag    ;}
     void ProcessPhotonCandidates();
     void ProcessClusters();
     void CalculatePi0Candidates();
+    void FindReaderIndices();
     void CalculateBackground();
     void CalculateBackgroundRP();
     void ProcessMCParticles();
@@ -300,6 +303,9 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     Double_t*                         fWeightCentrality;                          //[fnCuts], weight for centrality flattening
     Bool_t                            fEnableClusterCutsForTrigger;               //enables ClusterCuts for Trigger
     Bool_t                            fDoMaterialBudgetWeightingOfGammasForTrueMesons;
+    Bool_t                            fDoSharedMesonPairs;                        // build each meson candidate once per event for all cut sets
+    AliConversionMesonPairCache*      fMesonPairCache;                            //! meson candidates shared by the cut sets
+    vector<Int_t>                     fGammaReaderIndex;                          //! position of the current cut's gammas in fReaderGammas
     TTree*                            tBrokenFiles;                               // tree for keeping track of broken files
     TObjString*                       fFileNameBroken;                            // string object for broken file name
 
@@ -307,7 +313,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 42);
+    ClassDef(AliAnalysisTaskGammaConvV1, 43);
 };
 
 #endif
@@ -35,7 +35,9 @@
 #include "TChain.h"
 #include "TH1F.h"
 #include "TF1.h"
+#include "TVector2.h"
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <utility>
@@ -68,11 +70,37 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
   fSecVectorDeltaEtaDeltaPhi(0),
   fSecMap_TrID_ClID_ToIndex(),
   fSecMap_TrID_ClID_AlreadyTried(),
+  fSurfaceSource(NULL),
+  fSurfaceEvent(NULL),
+  fSurfaceEntry(-1),
+  fSurfaceStatus(),
+  fSurfaceEta(),
+  fSurfacePhi(),
+  fSurfacePt(),
+  fSurfacePos(),
+  fSurfaceParams(),
+  fSurfaceIndexBuilt(kFALSE),
+  fSurfaceCellFirst(),
+  fSurfaceCellTracks(),
+  fClusterGridCell(0),
+  fClusterCellFirst(),
+  fClusterCellClusters(),
+  fClusterAlways(),
+  fClusterCandidates(),
+  fSecSurfaceSlot(),
+  fSecSurfaceStatus(),
+  fSecSurfaceEta(),
+  fSecSurfacePhi(),
+  fSecSurfaceParams(),
   fListHistos(NULL),
   fHistControlMatches(NULL),
   fSecHistControlMatches(NULL)
 {
     // Default constructor
+    for(Int_t i = 0; i < 3; i++){
+      fClusterGridMin[i] = 0;
+      fClusterGridN[i] = 0;
+    }
     DefineInput(0, TChain::Class());
 }
 
@@ -166,6 +194,11 @@ void AliCaloTrackMatcher::Initialize(Int_t runNumber){
   fSecVectorDeltaEtaDeltaPhi.clear();
   fSecMap_TrID_ClID_ToIndex.clear();
   fSecMap_TrID_ClID_AlreadyTried.clear();
+  fSecSurfaceSlot.clear();
+  fSecSurfaceStatus.clear();
+  fSecSurfaceEta.clear();
+  fSecSurfacePhi.clear();
+  fSecSurfaceParams.clear();
 
   if(fRunNumber == -1 || fRunNumber != runNumber){
     if(fClusterType == 1 || fClusterType == 3){
@@ -199,86 +232,59 @@ void AliCaloTrackMatcher::UserExec(Option_t *){
 
 //________________________________________________________________________
 void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
-  Int_t nClus = event->GetNumberOfCaloClusters();
   Int_t nModules = 0;
   if(fClusterType == 1 || fClusterType == 3) nModules = fGeomEMCAL->GetNumberOfSuperModules();
   else if(fClusterType == 2) nModules = fGeomPHOS->GetNModules();
 
-  AliESDEvent *esdev = dynamic_cast<AliESDEvent*>(event);
-  AliAODEvent *aodev = 0;
-  if (!esdev) {
-    aodev = dynamic_cast<AliAODEvent*>(event);
-    if (!aodev) {
-      AliError("Task needs AOD or ESD event, returning");
-      return;
-    }
-  }
-
-  for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
-    AliExternalTrackParam *trackParam = 0;
-    AliVTrack *inTrack = 0x0;
-    if(esdev){
-      inTrack = esdev->GetTrack(itr);
-      if(!inTrack) continue;
-      fHistControlMatches->Fill(0.,inTrack->Pt());
-      AliESDtrack *esdt = dynamic_cast<AliESDtrack*>(inTrack);
-
-      const AliExternalTrackParam *in = esdt->GetInnerParam();
-      if (!in){AliDebug(2, "Could not get InnerParam of Track, continue"); fHistControlMatches->Fill(1.,inTrack->Pt()); continue;}
-      trackParam = new AliExternalTrackParam(*in);
-    } else if(aodev) {
-      inTrack = dynamic_cast<AliVTrack*>(aodev->GetTrack(itr));
-      if(!inTrack) continue;
-      fHistControlMatches->Fill(0.,inTrack->Pt());
-      AliAODTrack *aodt = dynamic_cast<AliAODTrack*>(inTrack);
+  // every track is propagated to the calorimeter surface only once per event, the table is
+  // shared with the other EMCal/DCal matcher of the train if there is one
+  if(!fSurfaceSource) fSurfaceSource = FindSurfaceSource();
+  if(!fSurfaceSource->PropagateTracksToSurface(event)) return;
+  Bool_t isAOD = (dynamic_cast<AliESDEvent*>(event) == NULL);
 
-      Double_t xyz[3] = {0}, pxpypz[3] = {0}, cv[21] = {0};
-      aodt->GetPxPyPz(pxpypz);
-      aodt->GetXYZ(xyz);
-      aodt->GetCovarianceXYZPxPyPz(cv);
-      trackParam = new AliExternalTrackParam(xyz,pxpypz,cv,aodt->Charge());
-    }
+  BuildClusterGrid(event);
 
-    if (!trackParam) {AliError("Could not get TrackParameters, continue"); fHistControlMatches->Fill(1.,inTrack->Pt()); continue;}
-    AliExternalTrackParam emcParam(*trackParam);
-    Float_t eta, phi, pt;
+  Int_t nTracks = fSurfaceSource->fSurfaceStatus.size();
+  for (Int_t itr=0;itr<nTracks;itr++){
+    Int_t status = fSurfaceSource->fSurfaceStatus[itr];
+    if(status == kSurfNoTrack) continue;
+    AliVTrack *inTrack = dynamic_cast<AliVTrack*>(event->GetTrack(itr));
+    if(!inTrack) continue;
+    fHistControlMatches->Fill(0.,inTrack->Pt());
+    if(status == kSurfNoParam){fHistControlMatches->Fill(1.,inTrack->Pt()); continue;}
 
-    //propagate tracks to emc surfaces
+    //tracks on emc surfaces
     if(fClusterType == 1 || fClusterType == 3){
-      if (!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., 0.139, 20., eta, phi, pt)) {
-        delete trackParam;
+      if(status == kSurfFailed){
         fHistControlMatches->Fill(2.,inTrack->Pt());
         continue;
       }
+      Float_t eta = fSurfaceSource->fSurfaceEta[itr];
+      Float_t phi = fSurfaceSource->fSurfacePhi[itr];
 
       if( TMath::Abs(eta) > 0.75 ) {
-        delete trackParam;
         fHistControlMatches->Fill(3.,inTrack->Pt());
         continue;
       }
       // Save some time and memory in case of no DCal present
       if( fClusterType == 1 && nModules < 13 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
-        delete trackParam;
         fHistControlMatches->Fill(3.,inTrack->Pt());
         continue;
       }
       // Save some time and memory in case of run2
       if( nModules > 12 ){
         if (fClusterType == 3 && ( phi < 250*TMath::DegToRad() || phi > 340*TMath::DegToRad())){
-          delete trackParam;
-	  fHistControlMatches->Fill(3.,inTrack->Pt());
+          fHistControlMatches->Fill(3.,inTrack->Pt());
           continue;
-        } 
+        }
         if( fClusterType == 1 && ( phi < 70*TMath::DegToRad() || phi > 190*TMath::DegToRad())){
-          delete trackParam;
           fHistControlMatches->Fill(3.,inTrack->Pt());
           continue;
         }
       }
 
     }else if(fClusterType == 2){
-      if( !AliTrackerBase::PropagateTrackToBxByBz(&emcParam, 460., 0.139, 20, kTRUE, 0.8, -1)){
-        delete trackParam;
+      if(status == kSurfFailed){
         fHistControlMatches->Fill(3.,inTrack->Pt());
         continue;
       }
@@ -287,20 +293,18 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
 
     Float_t dEta=-999, dPhi=-999;
     Float_t clsPos[3] = {0.,0.,0.};
-    Double_t exPos[3] = {0.,0.,0.};
-    if (!emcParam.GetXYZ(exPos)){ fHistControlMatches->Fill(2.,inTrack->Pt()); continue;}
+    if (status == kSurfNoXYZ){ fHistControlMatches->Fill(2.,inTrack->Pt()); continue;}
+    const Double_t *exPos = &fSurfaceSource->fSurfacePos[3*itr];
+    const AliExternalTrackParam &emcParam = fSurfaceSource->fSurfaceParams[itr];
 
-//cout << inTrack->GetID() << " - " << trackParam << endl;
-//cout << "eta/phi: " << eta << ", " << phi << endl;
-//cout << "nClus: " << nClus << endl;
+    // only the clusters in the neighbouring cells of the grid can be within the matching window
+    FindClusterCandidates(exPos);
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
-      AliVCluster* cluster = event->GetCaloCluster(iclus);
+    for(UInt_t icand=0;icand < fClusterCandidates.size();icand++){
+      AliVCluster* cluster = event->GetCaloCluster(fClusterCandidates[icand]);
       if (!cluster) continue;
-//cout << "-------------------------LOOPING: " << iclus << ", " << cluster->GetID() << endl;
       cluster->GetPosition(clsPos);
       Double_t dR = TMath::Sqrt(TMath::Power(exPos[0]-clsPos[0],2)+TMath::Power(exPos[1]-clsPos[1],2)+TMath::Power(exPos[2]-clsPos[2],2));
-//cout << "dR: " << dR << endl;
       if (dR > fMatchingWindow) continue;
       Double_t clusterR = TMath::Sqrt( clsPos[0]*clsPos[0] + clsPos[1]*clsPos[1] );
 
@@ -321,11 +325,9 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
 
 
       Float_t dR2 = dPhi*dPhi + dEta*dEta;
-//cout << dEta << " - " << dPhi << " - " << dR2 << endl;
       if(dR2 > fMatchingResidual) continue;
-//cout << "MATCHED!!!!!!!" << endl;
       nClusterMatchesToTrack++;
-      if(aodev){
+      if(isAOD){
         fMapTrackToCluster.insert(make_pair(itr,cluster->GetID()));
         fMapClusterToTrack.insert(make_pair(cluster->GetID(),itr));
       }else{
@@ -338,12 +340,305 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
     if(nClusterMatchesToTrack == 0) fHistControlMatches->Fill(5.,inTrack->Pt());
     else fHistControlMatches->Fill(6.,inTrack->Pt());
-    delete trackParam;
   }
 
   return;
 }
 
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::GetTrackParamAtStart(AliVTrack *track, AliExternalTrackParam &param){
+  // Track parameters the propagation to the calorimeters starts from: inner parameters for
+  // ESD tracks, parameters at the first point for AOD tracks
+  AliESDtrack *esdt = dynamic_cast<AliESDtrack*>(track);
+  if(esdt){
+    const AliExternalTrackParam *in = esdt->GetInnerParam();
+    if (!in) return kSurfNoParam;
+    param = *in;
+    return kSurfOK;
+  }
+  AliAODTrack *aodt = dynamic_cast<AliAODTrack*>(track);
+  if(!aodt) return kSurfNoTrack;
+  Double_t xyz[3] = {0}, pxpypz[3] = {0}, cv[21] = {0};
+  aodt->GetPxPyPz(pxpypz);
+  aodt->GetXYZ(xyz);
+  aodt->GetCovarianceXYZPxPyPz(cv);
+  param = AliExternalTrackParam(xyz,pxpypz,cv,aodt->Charge());
+  return kSurfOK;
+}
+
+//________________________________________________________________________
+AliCaloTrackMatcher* AliCaloTrackMatcher::FindSurfaceSource(){
+  // EMCal and DCal matchers propagate to the same surface with the same settings, hence all of
+  // them use the table of the first one registered in the analysis manager
+  if(fClusterType != 1 && fClusterType != 3) return this;
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if(!mgr || !mgr->GetTasks()) return this;
+  TIter next(mgr->GetTasks());
+  TObject *obj = 0x0;
+  while((obj = next())){
+    AliCaloTrackMatcher *matcher = dynamic_cast<AliCaloTrackMatcher*>(obj);
+    if(!matcher) continue;
+    if(matcher->GetClusterType() == 1 || matcher->GetClusterType() == 3) return matcher;
+  }
+  return this;
+}
+
+//________________________________________________________________________
+Bool_t AliCaloTrackMatcher::PropagateTracksToSurface(AliVEvent *event){
+  // Propagate all tracks of the event to the surface of the calorimeter of this matcher, the
+  // result is kept until the next event. Calling it again for the same event does nothing.
+  if(!event) return kFALSE;
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if(entry >= 0 && event == fSurfaceEvent && entry == fSurfaceEntry) return kTRUE;
+
+  if(!dynamic_cast<AliESDEvent*>(event) && !dynamic_cast<AliAODEvent*>(event)){
+    AliError("Task needs AOD or ESD event, returning");
+    return kFALSE;
+  }
+
+  Int_t nTracks = event->GetNumberOfTracks();
+  fSurfaceStatus.assign(nTracks,kSurfNoTrack);
+  fSurfaceEta.assign(nTracks,0);
+  fSurfacePhi.assign(nTracks,0);
+  fSurfacePt.assign(nTracks,0);
+  fSurfacePos.assign(3*nTracks,0);
+  if((Int_t)fSurfaceParams.size() < nTracks) fSurfaceParams.resize(nTracks);
+  fSurfaceIndexBuilt = kFALSE;
+
+  for (Int_t itr=0;itr<nTracks;itr++){
+    AliVTrack *inTrack = dynamic_cast<AliVTrack*>(event->GetTrack(itr));
+    if(!inTrack) continue;
+    AliExternalTrackParam &emcParam = fSurfaceParams[itr];
+    Int_t status = GetTrackParamAtStart(inTrack,emcParam);
+    if(status != kSurfOK){
+      fSurfaceStatus[itr] = status;
+      continue;
+    }
+
+    Float_t eta = 0, phi = 0, pt = 0;
+    if(fClusterType == 1 || fClusterType == 3){
+      if (!AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 440., 0.139, 20., eta, phi, pt)){
+        fSurfaceStatus[itr] = kSurfFailed;
+        continue;
+      }
+    }else if(fClusterType == 2){
+      if( !AliTrackerBase::PropagateTrackToBxByBz(&emcParam, 460., 0.139, 20, kTRUE, 0.8, -1)){
+        fSurfaceStatus[itr] = kSurfFailed;
+        continue;
+      }
+    }
+
+    Double_t *exPos = &fSurfacePos[3*itr];
+    Bool_t hasXYZ = emcParam.GetXYZ(exPos);
+    if(fClusterType == 2 && hasXYZ){
+      TVector3 exPosVec(exPos[0],exPos[1],exPos[2]);
+      eta = exPosVec.Eta();
+      phi = TVector2::Phi_0_2pi(exPosVec.Phi());
+      pt = emcParam.Pt();
+    }
+    fSurfaceEta[itr] = eta;
+    fSurfacePhi[itr] = phi;
+    fSurfacePt[itr] = pt;
+    fSurfaceStatus[itr] = hasXYZ ? kSurfOK : kSurfNoXYZ;
+  }
+
+  fSurfaceEvent = event;
+  fSurfaceEntry = entry;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliCaloTrackMatcher::GetTrackOnSurface(Int_t trackPos, Float_t &eta, Float_t &phi, Float_t &pt){
+  // eta, phi and pt of a track on the calorimeter surface, trackPos being the position of the
+  // track in the event; kFALSE if the track could not be propagated
+  AliCaloTrackMatcher *source = fSurfaceSource ? fSurfaceSource : this;
+  if(trackPos < 0 || trackPos >= (Int_t)source->fSurfaceStatus.size()) return kFALSE;
+  if(source->fSurfaceStatus[trackPos] != kSurfOK) return kFALSE;
+  eta = source->fSurfaceEta[trackPos];
+  phi = source->fSurfacePhi[trackPos];
+  pt = source->fSurfacePt[trackPos];
+  return kTRUE;
+}
+
+//________________________________________________________________________
+const AliExternalTrackParam* AliCaloTrackMatcher::GetTrackParamOnSurface(Int_t trackPos){
+  AliCaloTrackMatcher *source = fSurfaceSource ? fSurfaceSource : this;
+  if(trackPos < 0 || trackPos >= (Int_t)source->fSurfaceStatus.size()) return NULL;
+  if(source->fSurfaceStatus[trackPos] != kSurfOK) return NULL;
+  return &source->fSurfaceParams[trackPos];
+}
+
+//________________________________________________________________________
+vector<Int_t> AliCaloTrackMatcher::GetTracksOnSurfaceInCone(Float_t eta, Float_t phi, Float_t dR){
+  // positions of the tracks whose (eta,phi) on the calorimeter surface is closer than dR to
+  // (eta,phi), in increasing order
+  vector<Int_t> tracks;
+  AliCaloTrackMatcher *source = fSurfaceSource ? fSurfaceSource : this;
+  if(source != this) return source->GetTracksOnSurfaceInCone(eta,phi,dR);
+  if(!fSurfaceIndexBuilt) BuildSurfaceIndex();
+
+  const Int_t nEtaCells = 40;
+  const Int_t nPhiCells = 126;
+  const Float_t phiCellWidth = TMath::TwoPi()/nPhiCells;
+  Int_t etaFirst = SurfaceEtaCell(eta-dR);
+  Int_t etaLast = SurfaceEtaCell(eta+dR);
+  Int_t phiFirst = TMath::FloorNint((phi-dR)/phiCellWidth);
+  Int_t phiLast = TMath::FloorNint((phi+dR)/phiCellWidth);
+  if(phiLast-phiFirst >= nPhiCells){
+    phiFirst = 0;
+    phiLast = nPhiCells-1;
+  }
+  for(Int_t ieta = etaFirst; ieta <= etaLast && ieta < nEtaCells; ieta++){
+    for(Int_t jphi = phiFirst; jphi <= phiLast; jphi++){
+      Int_t iphi = ((jphi % nPhiCells) + nPhiCells) % nPhiCells;
+      Int_t c = ieta*nPhiCells + iphi;
+      for(Int_t k = fSurfaceCellFirst[c]; k < fSurfaceCellFirst[c+1]; k++){
+        Int_t itr = fSurfaceCellTracks[k];
+        Float_t dEta = eta - fSurfaceEta[itr];
+        Float_t dPhi = TVector2::Phi_mpi_pi(phi - fSurfacePhi[itr]);
+        if(TMath::Sqrt(dEta*dEta + dPhi*dPhi) < dR) tracks.push_back(itr);
+      }
+    }
+  }
+  sort(tracks.begin(),tracks.end());
+  return tracks;
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::BuildSurfaceIndex(){
+  // counting sort of the propagated tracks into (eta,phi) cells of the surface table, tracks
+  // outside of |eta| < 1 go to the outermost eta cells
+  const Int_t nEtaCells = 40;
+  const Int_t nPhiCells = 126;
+  Int_t nCells = nEtaCells*nPhiCells;
+  Int_t nTracks = fSurfaceStatus.size();
+  vector<Int_t> cell(nTracks,-1);
+  fSurfaceCellFirst.assign(nCells+1,0);
+  for(Int_t itr = 0; itr < nTracks; itr++){
+    if(fSurfaceStatus[itr] != kSurfOK) continue;
+    cell[itr] = SurfaceEtaCell(fSurfaceEta[itr])*nPhiCells + SurfacePhiCell(fSurfacePhi[itr]);
+    fSurfaceCellFirst[cell[itr]+1]++;
+  }
+  for(Int_t c = 0; c < nCells; c++) fSurfaceCellFirst[c+1] += fSurfaceCellFirst[c];
+  fSurfaceCellTracks.resize(fSurfaceCellFirst[nCells]);
+  vector<Int_t> fillPos(fSurfaceCellFirst.begin(),fSurfaceCellFirst.end()-1);
+  for(Int_t itr = 0; itr < nTracks; itr++){
+    if(cell[itr] < 0) continue;
+    fSurfaceCellTracks[fillPos[cell[itr]]++] = itr;
+  }
+  fSurfaceIndexBuilt = kTRUE;
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::SurfaceEtaCell(Float_t eta) const {
+  Int_t ieta = TMath::FloorNint((eta+1.)/0.05);
+  if(ieta < 0) ieta = 0;
+  if(ieta > 39) ieta = 39;
+  return ieta;
+}
+
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::SurfacePhiCell(Float_t phi) const {
+  Int_t iphi = TMath::FloorNint(TVector2::Phi_0_2pi(phi)/(TMath::TwoPi()/126));
+  if(iphi < 0) iphi = 0;
+  if(iphi > 125) iphi = 125;
+  return iphi;
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::BuildClusterGrid(AliVEvent *event){
+  // Sort the clusters of the event into a spatial grid with cells as large as the matching
+  // window. A cluster within the matching window of a track is always in one of the 27 cells
+  // around the track position.
+  Int_t nClus = event->GetNumberOfCaloClusters();
+  fClusterCellFirst.clear();
+  fClusterCellClusters.clear();
+  fClusterAlways.clear();
+  for(Int_t i = 0; i < 3; i++) fClusterGridN[i] = 0;
+
+  vector<Double_t> pos(3*nClus,0);
+  vector<Bool_t> inGrid(nClus,kFALSE);
+  Double_t posMax[3] = {0,0,0};
+  Bool_t first = kTRUE;
+  Float_t clsPos[3] = {0.,0.,0.};
+  for(Int_t iclus = 0; iclus < nClus; iclus++){
+    AliVCluster* cluster = event->GetCaloCluster(iclus);
+    if (!cluster) continue;
+    cluster->GetPosition(clsPos);
+    if(fMatchingWindow <= 0 || !TMath::Finite(fMatchingWindow) ||
+       !TMath::Finite(clsPos[0]) || !TMath::Finite(clsPos[1]) || !TMath::Finite(clsPos[2])){
+      fClusterAlways.push_back(iclus);
+      continue;
+    }
+    inGrid[iclus] = kTRUE;
+    for(Int_t i = 0; i < 3; i++){
+      pos[3*iclus+i] = clsPos[i];
+      if(first || clsPos[i] < fClusterGridMin[i]) fClusterGridMin[i] = clsPos[i];
+      if(first || clsPos[i] > posMax[i]) posMax[i] = clsPos[i];
+    }
+    first = kFALSE;
+  }
+  if(first) return;
+
+  // keep the number of cells reasonable for very small matching windows
+  fClusterGridCell = fMatchingWindow;
+  for(Int_t i = 0; i < 3; i++)
+    if((posMax[i]-fClusterGridMin[i])/fClusterGridCell > 50) fClusterGridCell = (posMax[i]-fClusterGridMin[i])/50;
+  for(Int_t i = 0; i < 3; i++) fClusterGridN[i] = TMath::FloorNint((posMax[i]-fClusterGridMin[i])/fClusterGridCell) + 1;
+
+  Int_t nCells = fClusterGridN[0]*fClusterGridN[1]*fClusterGridN[2];
+  vector<Int_t> cell(nClus,-1);
+  fClusterCellFirst.assign(nCells+1,0);
+  for(Int_t iclus = 0; iclus < nClus; iclus++){
+    if(!inGrid[iclus]) continue;
+    Int_t idx[3];
+    for(Int_t i = 0; i < 3; i++){
+      idx[i] = TMath::FloorNint((pos[3*iclus+i]-fClusterGridMin[i])/fClusterGridCell);
+      if(idx[i] >= fClusterGridN[i]) idx[i] = fClusterGridN[i]-1;
+    }
+    cell[iclus] = (idx[0]*fClusterGridN[1] + idx[1])*fClusterGridN[2] + idx[2];
+    fClusterCellFirst[cell[iclus]+1]++;
+  }
+  for(Int_t c = 0; c < nCells; c++) fClusterCellFirst[c+1] += fClusterCellFirst[c];
+  fClusterCellClusters.resize(fClusterCellFirst[nCells]);
+  vector<Int_t> fillPos(fClusterCellFirst.begin(),fClusterCellFirst.end()-1);
+  for(Int_t iclus = 0; iclus < nClus; iclus++){
+    if(cell[iclus] < 0) continue;
+    fClusterCellClusters[fillPos[cell[iclus]]++] = iclus;
+  }
+}
+
+//________________________________________________________________________
+void AliCaloTrackMatcher::FindClusterCandidates(const Double_t pos[3]){
+  // clusters which may be within the matching window of a track at pos, in the order of the
+  // event, such that the matches are stored in the same order as without the grid
+  fClusterCandidates.assign(fClusterAlways.begin(),fClusterAlways.end());
+  if(fClusterGridN[0] > 0){
+    Int_t lo[3], hi[3];
+    Bool_t outside = kFALSE;
+    for(Int_t i = 0; i < 3; i++){
+      Int_t idx = TMath::FloorNint((pos[i]-fClusterGridMin[i])/fClusterGridCell);
+      lo[i] = TMath::Max(0,idx-1);
+      hi[i] = TMath::Min(fClusterGridN[i]-1,idx+1);
+      if(!TMath::Finite(pos[i])){
+        lo[i] = 0;
+        hi[i] = fClusterGridN[i]-1;
+      }
+      if(lo[i] > hi[i]) outside = kTRUE;
+    }
+    for(Int_t ix = lo[0]; !outside && ix <= hi[0]; ix++){
+      for(Int_t iy = lo[1]; iy <= hi[1]; iy++){
+        for(Int_t iz = lo[2]; iz <= hi[2]; iz++){
+          Int_t c = (ix*fClusterGridN[1] + iy)*fClusterGridN[2] + iz;
+          fClusterCandidates.insert(fClusterCandidates.end(),fClusterCellClusters.begin()+fClusterCellFirst[c],fClusterCellClusters.begin()+fClusterCellFirst[c+1]);
+        }
+      }
+    }
+  }
+  sort(fClusterCandidates.begin(),fClusterCandidates.end());
+}
+
 //________________________________________________________________________
 Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliVTrack* inSecTrack, AliVCluster* cluster, AliVEvent* event, Float_t &dEta, Float_t &dPhi){
 
@@ -383,79 +678,66 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
   if(!inSecTrack) return kFALSE;
   fSecHistControlMatches->Fill(0.,inSecTrack->Pt());
 
-  AliESDtrack *esdt = dynamic_cast<AliESDtrack*>(inSecTrack);
-  AliAODTrack *aodt = 0;
-  if (!esdt) {
-    aodt = dynamic_cast<AliAODTrack*>(inSecTrack);
-    if (!aodt){
+  Bool_t propagated = kFALSE;
+  AliExternalTrackParam emcParam;
+  Float_t dPhiTemp = 0;
+  Float_t dEtaTemp = 0;
+
+  if(cluster->IsEMCAL()){
+    // the V0-track is propagated to the EMCal surface only once per event, whatever the number of clusters it is tried with
+    Int_t slot = PropagateSecTrackToSurface(inSecTrack);
+    Int_t status = fSecSurfaceStatus[slot];
+    if(status == kSurfNoTrack){
       AliError("Track is neither ESD nor AOD, continue");
       fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
       return kFALSE;
     }
-  }
-
-  AliExternalTrackParam *trackParam = 0;
-  if (esdt) {
-    const AliExternalTrackParam *in = esdt->GetInnerParam();
-    if (!in){
+    if(status == kSurfNoParam){
       AliDebug(2, "Could not get InnerParam of Track, continue");
       fSecHistControlMatches->Fill(1.,inSecTrack->Pt());
       fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
       return kFALSE;
     }
-    trackParam = new AliExternalTrackParam(*in);
-  } else {
-    Double_t xyz[3] = {0}, pxpypz[3] = {0}, cv[21] = {0};
-    aodt->GetPxPyPz(pxpypz);
-    aodt->GetXYZ(xyz);
-    aodt->GetCovarianceXYZPxPyPz(cv);
-    trackParam = new AliExternalTrackParam(xyz,pxpypz,cv,aodt->Charge());
-  }
-  if(!trackParam){
-    AliError("Could not get TrackParameters, continue");
-    fSecHistControlMatches->Fill(1.,inSecTrack->Pt());
-    fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
-    return kFALSE;
-  }
-
-  Bool_t propagated = kFALSE;
-  AliExternalTrackParam emcParam(*trackParam);
-  Float_t dPhiTemp = 0;
-  Float_t dEtaTemp = 0;
-
-  if(cluster->IsEMCAL()){
-    Float_t eta = 0;Float_t phi = 0;Float_t pt = 0;
-    propagated = AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 430, 0.000510999, 20, eta, phi, pt);
-    if(propagated){
-      if( TMath::Abs(eta) > 0.8 ) {
-        delete trackParam;
-        fSecHistControlMatches->Fill(3.,inSecTrack->Pt());
-        fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
-        return kFALSE;
-      }
-      // Save some time and memory in case of no DCal present
-      if( nModules < 13 && ( phi < 60*TMath::DegToRad() || phi > 200*TMath::DegToRad())){
-        delete trackParam;
-        fSecHistControlMatches->Fill(3.,inSecTrack->Pt());
-        fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
-        return kFALSE;
-      }
-
-      propagated = AliEMCALRecoUtils::ExtrapolateTrackToCluster(&emcParam, cluster, 0.000510999, 5, dEtaTemp, dPhiTemp);
-      if(!propagated){
-        delete trackParam;
-        fSecHistControlMatches->Fill(4.,inSecTrack->Pt());
-        fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
-        return kFALSE;
-      }
-    }else{
-      delete trackParam;
+    if(status == kSurfFailed){
       fSecHistControlMatches->Fill(2.,inSecTrack->Pt());
       fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
       return kFALSE;
     }
+    Float_t eta = fSecSurfaceEta[slot];
+    Float_t phi = fSecSurfacePhi[slot];
+    if( TMath::Abs(eta) > 0.8 ) {
+      fSecHistControlMatches->Fill(3.,inSecTrack->Pt());
+      fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
+      return kFALSE;
+    }
+    // Save some time and memory in case of no DCal present
+    if( nModules < 13 && ( phi < 60*TMath::DegToRad() || phi > 200*TMath::DegToRad())){
+      fSecHistControlMatches->Fill(3.,inSecTrack->Pt());
+      fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
+      return kFALSE;
+    }
+
+    emcParam = fSecSurfaceParams[slot];
+    propagated = AliEMCALRecoUtils::ExtrapolateTrackToCluster(&emcParam, cluster, 0.000510999, 5, dEtaTemp, dPhiTemp);
+    if(!propagated){
+      fSecHistControlMatches->Fill(4.,inSecTrack->Pt());
+      fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
+      return kFALSE;
+    }
 
   }else if(cluster->IsPHOS()){
+    Int_t status = GetTrackParamAtStart(inSecTrack,emcParam);
+    if(status == kSurfNoTrack){
+      AliError("Track is neither ESD nor AOD, continue");
+      fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
+      return kFALSE;
+    }
+    if(status == kSurfNoParam){
+      AliDebug(2, "Could not get InnerParam of Track, continue");
+      fSecHistControlMatches->Fill(1.,inSecTrack->Pt());
+      fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
+      return kFALSE;
+    }
     propagated = AliTrackerBase::PropagateTrackToBxByBz(&emcParam, clusterR, 0.000510999, 20, kTRUE, 0.8, -1);
     if (propagated){
       Double_t trkPos[3] = {0,0,0};
@@ -465,7 +747,6 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
       dPhiTemp = clsPosVec.DeltaPhi(trkPosVec);
       dEtaTemp = clsPosVec.Eta()-trkPosVec.Eta();
     }else{
-      delete trackParam;
       fSecHistControlMatches->Fill(2.,inSecTrack->Pt());
       fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
       return kFALSE;}
@@ -478,7 +759,6 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
       fSecHistControlMatches->Fill(5.,inSecTrack->Pt());
       fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
 //cout << "NO MATCH! - " << inSecTrack->GetID() << "/" << cluster->GetID() << endl;
-      delete trackParam;
       return kFALSE;
     }
 //cout << "MATCHED!!!!!!!" << endl;
@@ -507,15 +787,39 @@ Bool_t AliCaloTrackMatcher::PropagateV0TrackToClusterAndGetMatchingResidual(AliV
     fSecHistControlMatches->Fill(6.,inSecTrack->Pt());
     dEta = dEtaTemp;
     dPhi = dPhiTemp;
-    delete trackParam;
     return kTRUE;
   }else AliFatal("Fatal error in AliCaloTrackMatcher, track is labeled as sucessfully propagated although this should be impossible!");
 
   fSecMap_TrID_ClID_AlreadyTried[make_pair(inSecTrack->GetID(),cluster->GetID())] = 1.;
-  delete trackParam;
   return kFALSE;
 }
 
+//________________________________________________________________________
+Int_t AliCaloTrackMatcher::PropagateSecTrackToSurface(AliVTrack *track){
+  // Propagate a V0-track to the EMCal surface with the electron mass, unless it was already
+  // done in this event. Returns the position of the result in the fSecSurface vectors.
+  map<Int_t,Int_t>::iterator it = fSecSurfaceSlot.find(track->GetID());
+  if(it != fSecSurfaceSlot.end()) return it->second;
+
+  Int_t slot = fSecSurfaceStatus.size();
+  fSecSurfaceSlot[track->GetID()] = slot;
+  fSecSurfaceParams.push_back(AliExternalTrackParam());
+  fSecSurfaceEta.push_back(0);
+  fSecSurfacePhi.push_back(0);
+
+  AliExternalTrackParam &emcParam = fSecSurfaceParams[slot];
+  Int_t status = GetTrackParamAtStart(track,emcParam);
+  if(status == kSurfOK){
+    Float_t eta = 0;Float_t phi = 0;Float_t pt = 0;
+    if(AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(&emcParam, 430, 0.000510999, 20, eta, phi, pt)){
+      fSecSurfaceEta[slot] = eta;
+      fSecSurfacePhi[slot] = phi;
+    }else status = kSurfFailed;
+  }
+  fSecSurfaceStatus.push_back(status);
+  return slot;
+}
+
 //________________________________________________________________________
 //________________________________________________________________________
 //________________________________________________________________________
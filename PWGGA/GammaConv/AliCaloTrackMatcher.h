@@ -4,6 +4,7 @@
 #include "AliAnalysisTaskSE.h"
 #include "AliEMCALGeometry.h"
 #include "AliPHOSGeometry.h"
+#include "AliExternalTrackParam.h"
 #include <vector>
 #include <map>
 #include <utility>
@@ -30,6 +31,14 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void SetAnalysisTrainMode(TString mode){fAnalysisTrainMode = mode; return;}
     void SetMatchingResidual(Float_t res) {fMatchingResidual = res; return;}
     void SetMatchingWindow(Float_t win) {fMatchingWindow = win; return;}
+    Int_t GetClusterType() const {return fClusterType;}
+
+    // per-event table of all tracks propagated to the calorimeter surface, indexed by the position
+    // of the track in the event; EMCal and DCal matchers of the same train share one table
+    Bool_t PropagateTracksToSurface(AliVEvent *event);
+    Bool_t GetTrackOnSurface(Int_t trackPos, Float_t &eta, Float_t &phi, Float_t &pt);
+    const AliExternalTrackParam* GetTrackParamOnSurface(Int_t trackPos);
+    vector<Int_t> GetTracksOnSurfaceInCone(Float_t eta, Float_t phi, Float_t dR);
 
     // for cluster <-> primary matching
     Bool_t GetTrackClusterMatchingResidual(Int_t trackID, Int_t clusterID, Float_t &dEta, Float_t &dPhi);
@@ -80,6 +89,9 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     typedef pair<Float_t, Float_t> pairFloat;
     typedef map<pairInt, Int_t> mapT;
 
+    // outcome of the propagation of a track to the calorimeter surface
+    enum SurfaceStatus_t { kSurfOK = 0, kSurfNoTrack, kSurfNoParam, kSurfFailed, kSurfNoXYZ };
+
     AliCaloTrackMatcher (const AliCaloTrackMatcher&); // not implemented
     AliCaloTrackMatcher & operator=(const AliCaloTrackMatcher&); // not implemented
 
@@ -87,6 +99,14 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     void Initialize(Int_t runNumber);
     void ProcessEvent(AliVEvent *event);
     void SetLogBinningYTH2(TH2* histoRebin);
+    Int_t GetTrackParamAtStart(AliVTrack *track, AliExternalTrackParam &param);
+    AliCaloTrackMatcher* FindSurfaceSource();
+    void BuildSurfaceIndex();
+    Int_t SurfaceEtaCell(Float_t eta) const;
+    Int_t SurfacePhiCell(Float_t phi) const;
+    void BuildClusterGrid(AliVEvent *event);
+    void FindClusterCandidates(const Double_t pos[3]);
+    Int_t PropagateSecTrackToSurface(AliVTrack *track);
 
     // debug methods
     void DebugMatching();
@@ -119,12 +139,42 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     mapT                  fSecMap_TrID_ClID_ToIndex;  // map tuple of (V0-trackID,clusterID) to index in vector fSecVectorDeltaEtaDeltaPhi
     mapT                  fSecMap_TrID_ClID_AlreadyTried;  // map tuple of (V0-trackID,clusterID) to matching outcome, successful or not
 
+    // table of the tracks on the calorimeter surface
+    AliCaloTrackMatcher*  fSurfaceSource;             //! matcher providing the surface table (this or another EMCal/DCal matcher)
+    AliVEvent*            fSurfaceEvent;              //! event the surface table belongs to
+    Long64_t              fSurfaceEntry;              //! analysis entry the surface table belongs to
+    vector<Char_t>        fSurfaceStatus;             //! propagation outcome (SurfaceStatus_t) per track
+    vector<Float_t>       fSurfaceEta;                //! eta on the surface per track
+    vector<Float_t>       fSurfacePhi;                //! phi on the surface per track
+    vector<Float_t>       fSurfacePt;                 //! pt on the surface per track
+    vector<Double_t>      fSurfacePos;                //! x,y,z on the surface per track
+    vector<AliExternalTrackParam> fSurfaceParams;     //! track parameters on the surface per track
+    Bool_t                fSurfaceIndexBuilt;         //! whether the (eta,phi) index of the table is up to date
+    vector<Int_t>         fSurfaceCellFirst;          //! first entry of each (eta,phi) cell in fSurfaceCellTracks
+    vector<Int_t>         fSurfaceCellTracks;         //! track positions sorted by (eta,phi) cell
+
+    // spatial grid of the clusters, cell size given by the matching window
+    Double_t              fClusterGridMin[3];         //! lower edge of the grid in x,y,z
+    Double_t              fClusterGridCell;           //! cell size of the grid
+    Int_t                 fClusterGridN[3];           //! number of cells in x,y,z
+    vector<Int_t>         fClusterCellFirst;          //! first entry of each cell in fClusterCellClusters
+    vector<Int_t>         fClusterCellClusters;       //! cluster indices sorted by cell
+    vector<Int_t>         fClusterAlways;             //! clusters which are candidates for every track
+    vector<Int_t>         fClusterCandidates;         //! candidate clusters of the current track
+
+    // V0-tracks on the EMCal surface, computed once per V0-track and event
+    map<Int_t,Int_t>      fSecSurfaceSlot;            //! V0-trackID to position in the vectors below
+    vector<Char_t>        fSecSurfaceStatus;          //! propagation outcome (SurfaceStatus_t) per V0-track
+    vector<Float_t>       fSecSurfaceEta;             //! eta on the surface per V0-track
+    vector<Float_t>       fSecSurfacePhi;             //! phi on the surface per V0-track
+    vector<AliExternalTrackParam> fSecSurfaceParams;  //! track parameters on the surface per V0-track
+
     //histos
     TList*                fListHistos;             // list with histogram(s)
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,3)
+    ClassDef(AliCaloTrackMatcher,4)
 };
 
 #endif
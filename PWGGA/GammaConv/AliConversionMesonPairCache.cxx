@@ -0,0 +1,125 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Per-event cache of meson candidates, shared by all cut sets of a task
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "AliConversionMesonPairCache.h"
+
+#include "TClonesArray.h"
+#include "AliLog.h"
+#include "AliVVertex.h"
+#include "AliAODConversionPhoton.h"
+#include "AliAODConversionMother.h"
+
+ClassImp(AliConversionMesonPairCache)
+
+//________________________________________________________________________
+AliConversionMesonPairCache::AliConversionMesonPairCache() :
+  TObject(),
+  fN1(0),
+  fN2(0),
+  fEvent(0),
+  fStamp(),
+  fSlot(),
+  fInput(),
+  fPairs(new TClonesArray("AliAODConversionMother",100)),
+  fNBuilt(0),
+  fNReused(0)
+{
+}
+
+//________________________________________________________________________
+AliConversionMesonPairCache::~AliConversionMesonPairCache()
+{
+  if (fPairs){
+    fPairs->Delete();
+    delete fPairs;
+  }
+}
+
+//________________________________________________________________________
+void AliConversionMesonPairCache::NewEvent(Int_t n1, Int_t n2){
+  // Forget the pairs of the previous event. The (i1,i2) table is not
+  // cleared, entries of previous events are recognised by their stamp.
+  fPairs->Delete();
+  fInput.clear();
+  fN1 = n1 > 0 ? n1 : 0;
+  fN2 = n2 > 0 ? n2 : 0;
+  fEvent++;
+  if (fEvent == 0){
+    fStamp.assign(fStamp.size(), 0);
+    fEvent = 1;
+  }
+  UInt_t size = (UInt_t)fN1*(UInt_t)fN2;
+  if (size > fStamp.size()){
+    fStamp.resize(size, 0);
+    fSlot.resize(size, -1);
+  }
+}
+
+//________________________________________________________________________
+AliAODConversionMother* AliConversionMesonPairCache::GetPair(Int_t i1, Int_t i2,
+                                                             const AliAODConversionPhoton *gamma0,
+                                                             const AliAODConversionPhoton *gamma1,
+                                                             const AliVVertex *primVertex){
+  // Return the meson candidate built from gamma0 (index i1) and gamma1 (index i2),
+  // building it if needed. If primVertex is given, the distance of closest
+  // approach to it is calculated as well. The caller must use the same
+  // primVertex setting for all cut sets of an event.
+  if (i1 < 0 || i1 >= fN1 || i2 < 0 || i2 >= fN2){
+    AliError(Form("Photon index (%d,%d) outside of (%d,%d), call NewEvent() first", i1, i2, fN1, fN2));
+    return 0x0;
+  }
+
+  Int_t entry = i1*fN2 + i2;
+  AliAODConversionMother *pair = 0x0;
+  if (fStamp[entry] == fEvent){
+    Int_t slot = fSlot[entry];
+    pair = static_cast<AliAODConversionMother*>(fPairs->UncheckedAt(slot));
+    if (SameInput(slot, gamma0, gamma1)){
+      fNReused++;
+      return pair;
+    }
+    // the photons were modified since the pair was built, rebuild it in place
+    pair->~AliAODConversionMother();
+    pair = new(pair) AliAODConversionMother(gamma0,gamma1);
+    StoreInput(slot, gamma0, gamma1);
+  } else {
+    Int_t slot = fPairs->GetEntriesFast();
+    pair = new((*fPairs)[slot]) AliAODConversionMother(gamma0,gamma1);
+    fStamp[entry] = fEvent;
+    fSlot[entry] = slot;
+    fInput.resize(8*(slot+1));
+    StoreInput(slot, gamma0, gamma1);
+  }
+  if (primVertex) pair->CalculateDistanceOfClossetApproachToPrimVtx(primVertex);
+  fNBuilt++;
+  return pair;
+}
+
+//________________________________________________________________________
+void AliConversionMesonPairCache::StoreInput(Int_t slot, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1){
+  Double_t *input = &fInput[8*slot];
+  input[0] = gamma0->Px(); input[1] = gamma0->Py(); input[2] = gamma0->Pz(); input[3] = gamma0->E();
+  input[4] = gamma1->Px(); input[5] = gamma1->Py(); input[6] = gamma1->Pz(); input[7] = gamma1->E();
+}
+
+//________________________________________________________________________
+Bool_t AliConversionMesonPairCache::SameInput(Int_t slot, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1) const {
+  const Double_t *input = &fInput[8*slot];
+  return input[0] == gamma0->Px() && input[1] == gamma0->Py() && input[2] == gamma0->Pz() && input[3] == gamma0->E() &&
+         input[4] == gamma1->Px() && input[5] == gamma1->Py() && input[6] == gamma1->Pz() && input[7] == gamma1->E();
+}
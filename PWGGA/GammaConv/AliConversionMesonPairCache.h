@@ -0,0 +1,67 @@
+#ifndef ALICONVERSIONMESONPAIRCACHE_H
+#define ALICONVERSIONMESONPAIRCACHE_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Per-event cache of meson candidates (photon pairs), shared by all
+// cut sets of a task.
+//
+// The photons are identified by their index in the event (position in
+// the V0 reader array for conversion photons, cluster index for calo
+// photons). The first cut set which needs a pair builds it, the
+// following ones get the same object back. A pair is only reused if the
+// four-momenta of both photons are bitwise the same as when it was
+// built, hence cut sets which modify the photons (e.g. MC momentum
+// smearing) transparently get their own pairs.
+//
+// The pairs are owned by the cache and must not be deleted.
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "TObject.h"
+#include <vector>
+
+class TClonesArray;
+class AliVVertex;
+class AliAODConversionPhoton;
+class AliAODConversionMother;
+
+class AliConversionMesonPairCache : public TObject {
+
+  public:
+    AliConversionMesonPairCache();
+    virtual ~AliConversionMesonPairCache();
+
+    // to be called at the beginning of each event, n1 (n2) being the number of first (second) photons
+    void                      NewEvent(Int_t n1, Int_t n2);
+    AliAODConversionMother*   GetPair(Int_t i1, Int_t i2,
+                                      const AliAODConversionPhoton *gamma0,
+                                      const AliAODConversionPhoton *gamma1,
+                                      const AliVVertex *primVertex = 0x0);
+
+    Long64_t                  GetNBuilt()  const { return fNBuilt  ; }
+    Long64_t                  GetNReused() const { return fNReused ; }
+
+  private:
+    AliConversionMesonPairCache(const AliConversionMesonPairCache&);            // not implemented
+    AliConversionMesonPairCache& operator=(const AliConversionMesonPairCache&); // not implemented
+
+    void                      StoreInput(Int_t slot, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1);
+    Bool_t                    SameInput(Int_t slot, const AliAODConversionPhoton *gamma0, const AliAODConversionPhoton *gamma1) const;
+
+    Int_t                     fN1;        //! number of first photons in the current event
+    Int_t                     fN2;        //! number of second photons in the current event
+    UInt_t                    fEvent;     //! stamp of the current event
+    std::vector<UInt_t>       fStamp;     //! event stamp of each (i1,i2) entry
+    std::vector<Int_t>        fSlot;      //! position of each (i1,i2) entry in fPairs
+    std::vector<Double_t>     fInput;     //! four-momenta of both photons each pair was built from
+    TClonesArray*             fPairs;     //! meson candidates of the current event
+    Long64_t                  fNBuilt;    //! number of pairs built
+    Long64_t                  fNReused;   //! number of pairs reused
+
+  ClassDef(AliConversionMesonPairCache,1);
+};
+
+#endif
@@ -558,7 +558,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliESDtrack *negtrack1 = 0;
   AliESDtrack *negtrack2 = 0;
   AliESDtrack *trackPi   = 0;
-  Double_t mompos1[3],mompos2[3],momneg1[3],momneg2[3];
+  Double_t mompos1[3],momneg1[3];
   //   AliESDtrack *posV0track = 0;
   //   AliESDtrack *negV0track = 0;
   Float_t dcaMax = fCutsD0toKpi->GetDCACut();
@@ -618,6 +618,17 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // table of the track momenta at the primary vertex, used for the
+  // invariant mass cuts of 3 and 4 prongs before the DCA calculation
+  Double_t *pxAtVtx = new Double_t[nSeleTrks>0 ? nSeleTrks : 1];
+  Double_t *pyAtVtx = new Double_t[nSeleTrks>0 ? nSeleTrks : 1];
+  Double_t *pzAtVtx = new Double_t[nSeleTrks>0 ? nSeleTrks : 1];
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+    Double_t momAtVtx[3];
+    ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk))->GetPxPyPz(momAtVtx);
+    pxAtVtx[iTrk]=momAtVtx[0]; pyAtVtx[iTrk]=momAtVtx[1]; pzAtVtx[iTrk]=momAtVtx[2];
+  }
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -1131,13 +1142,26 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
+	// check invariant mass cuts for D+,Ds,Lc
+	// (done before the DCA calculation, which is not needed for rejected triplets)
+        massCutOK=kTRUE;
+	if(f3Prong && fMassCutBeforeVertexing) {
+	  Double_t pxDau[3]={mompos1[0],momneg1[0],pxAtVtx[iTrkP2]};
+	  Double_t pyDau[3]={mompos1[1],momneg1[1],pyAtVtx[iTrkP2]};
+	  Double_t pzDau[3]={mompos1[2],momneg1[2],pzAtVtx[iTrkP2]};
+	  //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
+	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
+	  if(!massCutOK && !f4Prong) {
+	    postrack2=0;
+	    continue;
+	  }
+	}
+
 	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
 	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
-	// check invariant mass cuts for D+,Ds,Lc
-        massCutOK=kTRUE;
 	if(f3Prong) {
 	  if(postrack2->Charge()>0) {
 	    threeTrackArray->AddAt(postrack1,0);
@@ -1148,14 +1172,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    threeTrackArray->AddAt(postrack1,1);
 	    threeTrackArray->AddAt(postrack2,2);
 	  }
-	  if(fMassCutBeforeVertexing){
-	    postrack2->GetPxPyPz(mompos2);
-	    Double_t pxDau[3]={mompos1[0],momneg1[0],mompos2[0]};
-	    Double_t pyDau[3]={mompos1[1],momneg1[1],mompos2[1]};
-	    Double_t pzDau[3]={mompos1[2],momneg1[2],mompos2[2]};
-	    //	    massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
-	    massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
-	  }
 	}
 
 	if(f3Prong && !massCutOK) {
@@ -1275,6 +1291,20 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
+	    // check invariant mass cuts for D0 (before the DCA calculation)
+	    massCutOK=kTRUE;
+	    if(fMassCutBeforeVertexing) {
+	      Double_t pxDau[4]={pxAtVtx[iTrkP1],pxAtVtx[iTrkN1],pxAtVtx[iTrkP2],pxAtVtx[iTrkN2]};
+	      Double_t pyDau[4]={pyAtVtx[iTrkP1],pyAtVtx[iTrkN1],pyAtVtx[iTrkP2],pyAtVtx[iTrkN2]};
+	      Double_t pzDau[4]={pzAtVtx[iTrkP1],pzAtVtx[iTrkN1],pzAtVtx[iTrkP2],pzAtVtx[iTrkN2]};
+	      massCutOK = SelectInvMassAndPt4prong(pxDau,pyDau,pzDau);
+	    }
+
+	    if(!massCutOK) {
+	      negtrack2=0;
+	      continue;
+	    }
+
 	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
             dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
@@ -1286,17 +1316,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    fourTrackArray->AddAt(postrack2,2);
 	    fourTrackArray->AddAt(negtrack2,3);
 
-	    // check invariant mass cuts for D0
-	    massCutOK=kTRUE;
-	    if(fMassCutBeforeVertexing)
-	      massCutOK = SelectInvMassAndPt4prong(fourTrackArray);
-
-	    if(!massCutOK) {
-	      fourTrackArray->Clear();
-	      negtrack2=0;
-	      continue;
-	    }
-
 	    // Vertexing
 	    AliAODVertex* secVert4PrAOD = ReconstructSecondaryVertex(fourTrackArray,dispersion);
 	    io4Prong = Make4Prong(fourTrackArray,event,secVert4PrAOD,vertexp1n1,vertexp1n1p2,dcap1n1,dcap1n2,dcap2n1,dcap2n2,ok4Prong);
@@ -1409,31 +1428,30 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
-	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
-
-	threeTrackArray->AddAt(negtrack1,0);
-	threeTrackArray->AddAt(postrack1,1);
-	threeTrackArray->AddAt(negtrack2,2);
-
 	// check invariant mass cuts for D+,Ds,Lc
+	// (done before the DCA calculation, which is not needed for rejected triplets)
         massCutOK=kTRUE;
 	if(fMassCutBeforeVertexing && f3Prong){
-	  negtrack2->GetPxPyPz(momneg2);
-	  Double_t pxDau[3]={momneg1[0],mompos1[0],momneg2[0]};
-	  Double_t pyDau[3]={momneg1[1],mompos1[1],momneg2[1]};
-	  Double_t pzDau[3]={momneg1[2],mompos1[2],momneg2[2]};
+	  Double_t pxDau[3]={momneg1[0],mompos1[0],pxAtVtx[iTrkN2]};
+	  Double_t pyDau[3]={momneg1[1],mompos1[1],pyAtVtx[iTrkN2]};
+	  Double_t pzDau[3]={momneg1[2],mompos1[2],pzAtVtx[iTrkN2]};
 	  //	  massCutOK = SelectInvMassAndPt3prong(threeTrackArray);
 	  massCutOK = SelectInvMassAndPt3prong(pxDau,pyDau,pzDau,pidLcStatus);
 	}
 	if(!massCutOK) {
-	  threeTrackArray->Clear();
 	  negtrack2=0;
 	  continue;
 	}
 
+	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
+	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
+
+	threeTrackArray->AddAt(negtrack1,0);
+	threeTrackArray->AddAt(postrack1,1);
+	threeTrackArray->AddAt(negtrack2,2);
+
 	// Vertexing
 	twoTrackArray2->AddAt(postrack1,0);
 	twoTrackArray2->AddAt(negtrack2,1);
@@ -1545,6 +1563,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   threeTrackArray->Delete(); delete threeTrackArray;
   fourTrackArray->Delete();  delete fourTrackArray;
   delete [] seleFlags; seleFlags=NULL;
+  delete [] pxAtVtx; pxAtVtx=NULL;
+  delete [] pyAtVtx; pyAtVtx=NULL;
+  delete [] pzAtVtx; pzAtVtx=NULL;
   if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
   tracksAtVertex.Delete();
 
@@ -59,6 +59,9 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fPtgAxis(0),
   fDBCAxis(0),
   fJetRelativeEPAngle(0),
+  fUseMatchingPreselection(kFALSE),
+  fMatchingPreselRadius(-1),
+  fJetMatchingGrid(),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -148,6 +151,9 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fPtgAxis(0),
   fDBCAxis(0),
   fJetRelativeEPAngle(0),
+  fUseMatchingPreselection(kFALSE),
+  fMatchingPreselRadius(-1),
+  fJetMatchingGrid(),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -1429,12 +1435,24 @@ void AliJetResponseMaker::DoJetLoop()
   jets2->ResetCurrentID();
   while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
 
+  Double_t preselRadius = GetMatchingPreselectionRadius();
+  if (preselRadius > 0) fJetMatchingGrid.Fill(jets2, preselRadius);
+
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
     jet1->ResetMatching();
 
     if (jet1->MCPt() < fMinJetMCPt) continue;
 
+    if (preselRadius > 0) {
+      // only jets2 within the pre-selection radius, in the same order as the full loop
+      Int_t nCandidates = fJetMatchingGrid.FindCandidates(jet1->Eta(), jet1->Phi());
+      for (Int_t i = 0; i < nCandidates; i++) {
+        SetMatchingLevel(jet1, fJetMatchingGrid.GetCandidate(i), fMatching);
+      }
+      continue;
+    }
+
     jets2->ResetCurrentID();
     while ((jet2 = jets2->GetNextJet())) {
       SetMatchingLevel(jet1, jet2, fMatching);
@@ -1442,6 +1460,22 @@ void AliJetResponseMaker::DoJetLoop()
   } // jet1 loop
 }
 
+//________________________________________________________________________
+Double_t AliJetResponseMaker::GetMatchingPreselectionRadius() const
+{
+  // Radius in (eta,phi) within which jet pairs are considered for matching, <= 0 if all pairs are considered.
+  // The pre-selection is off unless enabled with SetMatchingPreselection(kTRUE).
+  // For geometrical matching pairs further apart than max(fMatchingPar1,fMatchingPar2) can never be matched,
+  // i.e. the matched pairs are the same as with the full loop. For the other matching types the radius
+  // has to be set explicitly (e.g. the sum of the jet radii).
+
+  if (!fUseMatchingPreselection) return -1;
+  if (fMatchingPreselRadius > 0) return fMatchingPreselRadius;
+  if (fMatching == kGeometrical) return TMath::Max(fMatchingPar1, fMatchingPar2);
+
+  return -1;
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -27,6 +27,7 @@ class AliNamedArrayI;
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
+#include "AliEmcalJetMatchingGrid.h"
 
 class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
  public:
@@ -59,6 +60,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetPtgAxis(Int_t b)                                             { fPtgAxis           = b         ; }
   void                        SetDBCAxis(Int_t b)                                             { fDBCAxis           = b         ; }
   void                        SetJetRelativeEPAngleAxis(Int_t b)                              { fJetRelativeEPAngle = b        ; }
+  void                        SetMatchingPreselection(Bool_t b, Double_t r=-1)                { fUseMatchingPreselection = b; fMatchingPreselRadius = r; }
 
   static AliJetResponseMaker * AddTaskJetResponseMaker(
       const char *ntracks1           = "Tracks",
@@ -97,6 +99,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Bool_t                      Run();
   Bool_t                      DoJetMatching();
   void                        SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, MatchingType matching);
+  Double_t                    GetMatchingPreselectionRadius() const;
   void                        GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const;
   void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
@@ -124,6 +127,9 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Int_t                       fPtgAxis;                                // add Ptg axis in matching THnSparse (default=0)
   Int_t                       fDBCAxis;                                // add DBC (number of soft dropped branches) axis in matching THnSparse (default=0)
   Int_t                       fJetRelativeEPAngle;                     ///< add jet angle relative to the EP in matching THnSparse (default=0)
+  Bool_t                      fUseMatchingPreselection;                // only evaluate the matching level of jet pairs closer than the pre-selection radius (default=off)
+  Double_t                    fMatchingPreselRadius;                   // pre-selection radius in (eta,phi), <= 0: max(fMatchingPar1,fMatchingPar2) for geometrical matching, no pre-selection otherwise
+  AliEmcalJetMatchingGrid     fJetMatchingGrid;                        //!<! (eta,phi) grid of the jet2 collection
 
   Bool_t                      fIsJet1Rho;                              //!whether the jet1 collection has to be average subtracted
   Bool_t                      fIsJet2Rho;                              //!whether the jet2 collection has to be average subtracted
@@ -204,6 +210,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
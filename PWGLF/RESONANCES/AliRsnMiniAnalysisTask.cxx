@@ -71,6 +71,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fMaxDiffMult(10),
    fMaxDiffVz(1.0),
    fMaxDiffAngle(1E20),
+   fMixOnline(kFALSE),
    fOutput(0x0),
    fHistograms("AliRsnMiniOutput", 0),
    fValues("AliRsnMiniValue", 0),
@@ -101,7 +102,10 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
    fKeepMotherInAcceptance(kFALSE),
-   fRsnTreeInFile(kFALSE)
+   fRsnTreeInFile(kFALSE),
+   fNMiniEvents(0),
+   fMixBuffer(),
+   fMixCount()
 {
 //
 // Dummy constructor ALWAYS needed for I/O.
@@ -128,6 +132,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC,Bo
    fMaxDiffMult(10),
    fMaxDiffVz(1.0),
    fMaxDiffAngle(1E20),
+   fMixOnline(kFALSE),
    fOutput(0x0),
    fHistograms("AliRsnMiniOutput", 0),
    fValues("AliRsnMiniValue", 0),
@@ -158,7 +163,10 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC,Bo
    fMotherAcceptanceCutMinPt(0.0),
    fMotherAcceptanceCutMaxEta(0.9),
    fKeepMotherInAcceptance(kFALSE),
-   fRsnTreeInFile(saveRsnTreeInFile)
+   fRsnTreeInFile(saveRsnTreeInFile),
+   fNMiniEvents(0),
+   fMixBuffer(),
+   fMixCount()
 {
 //
 // Default constructor.
@@ -191,6 +199,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fMaxDiffMult(copy.fMaxDiffMult),
    fMaxDiffVz(copy.fMaxDiffVz),
    fMaxDiffAngle(copy.fMaxDiffAngle),
+   fMixOnline(copy.fMixOnline),
    fOutput(0x0),
    fHistograms(copy.fHistograms),
    fValues(copy.fValues),
@@ -221,7 +230,10 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fMotherAcceptanceCutMinPt(copy.fMotherAcceptanceCutMinPt),
    fMotherAcceptanceCutMaxEta(copy.fMotherAcceptanceCutMaxEta),
    fKeepMotherInAcceptance(copy.fKeepMotherInAcceptance),
-   fRsnTreeInFile(copy.fRsnTreeInFile)
+   fRsnTreeInFile(copy.fRsnTreeInFile),
+   fNMiniEvents(0),
+   fMixBuffer(),
+   fMixCount()
 {
 //
 // Copy constructor.
@@ -259,6 +271,7 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fMaxDiffMult = copy.fMaxDiffMult;
    fMaxDiffVz = copy.fMaxDiffVz;
    fMaxDiffAngle = copy.fMaxDiffAngle;
+   fMixOnline = copy.fMixOnline;
    fHistograms = copy.fHistograms;
    fValues = copy.fValues;
    fHEventStat = copy.fHEventStat;
@@ -302,6 +315,7 @@ AliRsnMiniAnalysisTask::~AliRsnMiniAnalysisTask()
       delete fOutput;
       delete fEvBuffer;
    }
+   ClearMixBuffer();
 }
 
 //__________________________________________________________________________________________________
@@ -405,6 +419,14 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
       cs->Init(fOutput);
    }
 
+   // online mixing relies on the events of a bin being all compatible
+   if (fMixOnline && fContinuousMix) {
+      AliWarning("Online mixing requires binned mixing, falling back to mixing in FinishTaskOutput");
+      fMixOnline = kFALSE;
+   }
+   fNMiniEvents = 0;
+   ClearMixBuffer();
+
    // create temporary tree for filtered events
    if (fMiniEvent) SafeDelete(fMiniEvent);
    if (fRsnTreeInFile) OpenFile(2);
@@ -436,7 +458,8 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
 // Computation loop.
 // In this case, it checks if the event is acceptable, and eventually
 // creates the corresponding mini-event and stores it in the buffer.
-// The real histogram filling is done at the end, in "FinishTaskOutput".
+// The real histogram filling is done at the end, in "FinishTaskOutput",
+// unless online mixing is enabled: then the event is processed and mixed here.
 //
    // increment event counter
    fEvNum++;
@@ -466,6 +489,13 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
    // if the event is not empty, store it
    if (fMiniEvent->IsEmpty()) {
       AliDebugClass(2, Form("Rejecting empty event #%d", fEvNum));
+   } else if (fMixOnline) {
+      Int_t id = fNMiniEvents++;
+      AliDebugClass(2, Form("Processing event #%d with ID = %d", fEvNum, id));
+      fMiniEvent->ID() = id;
+      if (fRsnTreeInFile) fEvBuffer->Fill();
+      FillEventOutputs(id);
+      if (fNMix > 0) MixOnline();
    } else {
       Int_t id = fEvBuffer->GetEntries();
       AliDebugClass(2, Form("Adding event #%d with ID = %d", fEvNum, id));
@@ -488,15 +518,21 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
 // Here a loop is done on each of these events, and both single-event and mixing are computed
 //
 
+   // with online mixing everything was done in UserExec
+   if (fMixOnline) {
+      AliInfo(Form("[%s] Online mixing: %d events processed, %d still buffered", GetName(), fNMiniEvents, (Int_t)fMixCount.size()));
+      ClearMixBuffer();
+      PostData(1, fOutput);
+      if (fRsnTreeInFile) PostData(2, fEvBuffer);
+      return;
+   }
+
    // security code: reassign the buffer to the mini-event cursor
    fEvBuffer->SetBranchAddress("events", &fMiniEvent);
    TStopwatch timer;
    // prepare variables
    Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
-   Int_t idef, nDefs   = fHistograms.GetEntries();
    Int_t imix, iloop, ifill;
-   AliRsnMiniOutput *def = 0x0;
-   AliRsnMiniOutput::EComputation compType;
 
    Int_t printNum = fMixPrintRefresh;
    if (printNum < 0) {
@@ -518,41 +554,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
       }
       // fill
-      for (idef = 0; idef < nDefs; idef++) {
-         def = (AliRsnMiniOutput *)fHistograms[idef];
-         if (!def) continue;
-         compType = def->GetComputation();
-         // execute computation in the appropriate way
-         switch (compType) {
-            case AliRsnMiniOutput::kEventOnly:
-               //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
-               ifill = 1;
-               def->FillEvent(fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTruePair:
-               //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPair:
-               //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPairRotated1:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPairRotated2:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            default:
-               // other kinds are processed elsewhere
-               ifill = 0;
-               AliDebugClass(2, Form("Computation = %d", (Int_t)compType));
-         }
-         // message
-         AliDebugClass(1, Form("Event %6d: def = '%15s' -- fills = %5d", ievt, def->GetName(), ifill));
-      }
+      FillEventOutputs(ievt);
    }
 
    // if no mixing is required, stop here and post the output
@@ -623,16 +625,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       while ( (os = (TObjString *)next()) ) {
          imix = os->GetString().Atoi();
          fEvBuffer->GetEntry(imix);
-         for (idef = 0; idef < nDefs; idef++) {
-            def = (AliRsnMiniOutput *)fHistograms[idef];
-            if (!def) continue;
-            if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
-            if (!def->IsSymmetric()) {
-               AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
-            }
-         }
+         ifill += FillMixedPair(&evMain, fMiniEvent);
       }
       delete list;
    }
@@ -680,6 +673,133 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    if (fRsnTreeInFile) PostData(2, fEvBuffer);
 }
 
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FillEventOutputs(Int_t ievt)
+{
+//
+// Fill all single-event outputs (event values, true pairs, same-event and rotated pairs)
+// with the mini-event currently pointed by the cursor.
+//
+
+   Int_t idef, nDefs = fHistograms.GetEntries(), ifill;
+   AliRsnMiniOutput *def = 0x0;
+   AliRsnMiniOutput::EComputation compType;
+
+   for (idef = 0; idef < nDefs; idef++) {
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def) continue;
+      compType = def->GetComputation();
+      // execute computation in the appropriate way
+      switch (compType) {
+         case AliRsnMiniOutput::kEventOnly:
+            //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
+            ifill = 1;
+            def->FillEvent(fMiniEvent, &fValues);
+            break;
+         case AliRsnMiniOutput::kTruePair:
+            //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+            break;
+         case AliRsnMiniOutput::kTrackPair:
+            //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+            break;
+         case AliRsnMiniOutput::kTrackPairRotated1:
+            //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+            break;
+         case AliRsnMiniOutput::kTrackPairRotated2:
+            //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+            break;
+         default:
+            // other kinds are processed elsewhere
+            ifill = 0;
+            AliDebugClass(2, Form("Computation = %d", (Int_t)compType));
+      }
+      // message
+      AliDebugClass(1, Form("Event %6d: def = '%15s' -- fills = %5d", ievt, def->GetName(), ifill));
+   }
+}
+
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniAnalysisTask::FillMixedPair(AliRsnMiniEvent *evMain, AliRsnMiniEvent *evMix)
+{
+//
+// Fill all mixing outputs with the pairs of two matched events.
+// Returns the number of successful fillings.
+//
+
+   Int_t idef, nDefs = fHistograms.GetEntries(), ifill = 0;
+   AliRsnMiniOutput *def = 0x0;
+   for (idef = 0; idef < nDefs; idef++) {
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def) continue;
+      if (!def->IsTrackPairMix()) continue;
+      ifill += def->FillPair(evMain, evMix, &fValues, kTRUE);
+      if (!def->IsSymmetric()) {
+         AliDebugClass(2, "Reflecting non symmetric pair");
+         ifill += def->FillPair(evMix, evMain, &fValues, kFALSE);
+      }
+   }
+   return ifill;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::MixOnline()
+{
+//
+// Mix the mini-event currently pointed by the cursor with the previous events of its bin
+// which still need partners, oldest first, the older event being the main one.
+// Events which got fNMix partners are dropped, the current one is kept only if it still
+// needs partners, hence each bin holds at most fNMix events.
+// With binned mixing, this gives exactly the same pairs as the search in FinishTaskOutput:
+// there an event is mixed with the next compatible events which are not yet full, and
+// when the search wraps around to the beginning all compatible events which are not full
+// were already mixed with it.
+//
+
+   Int_t id = fMiniEvent->ID();
+   TString bin = Form("%d|%d|%d", (Int_t)(fMiniEvent->Vz() / fMaxDiffVz), (Int_t)(fMiniEvent->Mult() / fMaxDiffMult), (Int_t)(fMiniEvent->Angle() / fMaxDiffAngle));
+   std::vector<AliRsnMiniEvent*> &ring = fMixBuffer[bin];
+
+   Int_t nmatched = 0;
+   UInt_t i = 0;
+   while (i < ring.size() && nmatched < fNMix) {
+      AliRsnMiniEvent *evMain = ring[i];
+      FillMixedPair(evMain, fMiniEvent);
+      nmatched++;
+      if (++fMixCount[evMain->ID()] >= fNMix) {
+         fMixCount.erase(evMain->ID());
+         delete evMain;
+         ring.erase(ring.begin() + i);
+      } else {
+         i++;
+      }
+   }
+   AliDebugClass(1, Form("Matches for event %5d = %d (bin %s)", id, nmatched, bin.Data()));
+
+   if (nmatched < fNMix) {
+      ring.push_back(new AliRsnMiniEvent(*fMiniEvent));
+      fMixCount[id] = nmatched;
+   }
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::ClearMixBuffer()
+{
+//
+// Delete the events buffered for online mixing
+//
+
+   std::map<TString, std::vector<AliRsnMiniEvent*> >::iterator it;
+   for (it = fMixBuffer.begin(); it != fMixBuffer.end(); ++it) {
+      for (UInt_t i = 0; i < it->second.size(); i++) delete it->second[i];
+   }
+   fMixBuffer.clear();
+   fMixCount.clear();
+}
+
 //__________________________________________________________________________________________________
 void AliRsnMiniAnalysisTask::Terminate(Option_t *)
 {
@@ -15,6 +15,9 @@
 #include <TString.h>
 #include <TClonesArray.h>
 
+#include <map>
+#include <vector>
+
 #include "AliAnalysisTaskSE.h"
 
 #include "AliRsnEvent.h"
@@ -53,6 +56,7 @@ public:
    void                UseMultiplicity(const char *type)  {fUseCentrality = kFALSE; fCentralityType = type; if(!fCentralityType.Contains("AliMultSelection")) fCentralityType.ToUpper();}
    void                UseContinuousMix()                 {fContinuousMix = kTRUE;}
    void                UseBinnedMix()                     {fContinuousMix = kFALSE;}
+   void                SetMixOnline(Bool_t yn = kTRUE)    {fMixOnline = yn;}
    void                SetNMix(Int_t nmix)                {fNMix = nmix;}
    void                SetMaxDiffMult (Double_t val)      {fMaxDiffMult  = val;}
    void                SetMaxDiffVz   (Double_t val)      {fMaxDiffVz    = val;}
@@ -101,6 +105,10 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   void     FillEventOutputs(Int_t ievt);
+   Int_t    FillMixedPair(AliRsnMiniEvent *evMain, AliRsnMiniEvent *evMix);
+   void     MixOnline();
+   void     ClearMixBuffer();
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -123,6 +131,7 @@ private:
    Double_t             fMaxDiffMult;     //  mixing --> max difference in multiplicity
    Double_t             fMaxDiffVz;       //  mixing --> max difference in Vz of prim vert
    Double_t             fMaxDiffAngle;    //  mixing --> max difference in reaction plane angle
+   Bool_t               fMixOnline;       //  mixing --> done while the events arrive (binned mixing only)
 
    TList               *fOutput;          //  output list
    TClonesArray         fHistograms;      //  list of histogram definitions
@@ -158,7 +167,11 @@ private:
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
    Bool_t               fRsnTreeInFile;  // flag rsn tree should be saved in file instead of memory
 
-   ClassDef(AliRsnMiniAnalysisTask, 15);   // AliRsnMiniAnalysisTask
+   Int_t                                          fNMiniEvents; //! number of stored mini-events (online mixing)
+   std::map<TString, std::vector<AliRsnMiniEvent*> > fMixBuffer;  //! per mixing bin, events which still need partners (online mixing)
+   std::map<Int_t, Int_t>                         fMixCount;    //! number of partners of the buffered events, by ID (online mixing)
+
+   ClassDef(AliRsnMiniAnalysisTask, 16);   // AliRsnMiniAnalysisTask
 };
 
 
@@ -50,6 +50,7 @@
 #include "TFile.h"
 #include "TMatrixD.h"
 #include "TRandom3.h"
+#include <algorithm>
 
 #include "AliHeader.h"  
 #include "AliGenEventHeader.h"  
@@ -81,6 +82,7 @@
 #include "AliFilteredTreeAcceptanceCuts.h"
 
 #include "AliAnalysisTaskFilteredTree.h"
+#include "AliAsyncTreeWriter.h"
 #include "AliKFParticle.h"
 #include "AliESDv0.h"
 #include "AliPID.h"
@@ -110,6 +112,9 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fTrigger(AliTriggerAnalysis::kMB1) 
   , fAnalysisMode(kTPCAnalysisMode) 
   , fTreeSRedirector(0)
+  , fAsyncWriter(0)
+  , fAsyncEventsPerBuffer(0)
+  , fAsyncMaxQueued(2)
   , fCentralityEstimator(0)
   , fLowPtTrackDownscaligF(0)
   , fLowPtV0DownscaligF(0)
@@ -134,6 +139,9 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
   , fDummyTrack(0)
+  , fNearestTrackIndex()
+  , fNearestTrackIndexBuilt()
+  , fNearestTrackIndexEvent(0)
 {
   // Constructor
 
@@ -157,6 +165,7 @@ AliAnalysisTaskFilteredTree::~AliAnalysisTaskFilteredTree()
   delete fFilteredTreeAcceptanceCuts;
   delete fFilteredTreeRecAcceptanceCuts;
   delete fEsdTrackCuts;
+  delete fAsyncWriter;
 }
 
 //____________________________________________________________________________
@@ -206,6 +215,13 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
   fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
   fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  //
+  // asynchronous output: the event loop streams into staging buffers, the writer thread
+  // compresses and writes them to the trees above
+  if (fAsyncEventsPerBuffer>0) {
+    fAsyncWriter = new AliAsyncTreeWriter(fTreeSRedirector, fAsyncEventsPerBuffer, fAsyncMaxQueued);
+    fTreeSRedirector = fAsyncWriter->GetStream();
+  }
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -361,6 +377,7 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
   //
   //
   //
+  ResetNearestTrackIndex();  // track index for GetNearestTrack is rebuilt on demand for the new event
   if(fProcessAll) { 
     ProcessAll(fESD,fMC,fESDfriend); // all track stages and MC
   }
@@ -377,6 +394,7 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     //ProcessMC();  //TODO - enable MC detailed view switch after holidays
   }
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  if (fAsyncWriter) fTreeSRedirector = fAsyncWriter->Commit();
   printf("processed event %d\n", Int_t(Entry()));
 }
 
@@ -492,19 +510,11 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"CosmicPairs").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
-	  if (tree){
-	    Double_t sizeAll=tree->GetZipBytes();
-	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
-	    Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	    br= tree->GetBranch("friendTrack0.fCalibContainer");
-	    if (br) sizeFriend+=br->GetZipBytes();
-	    if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
-	      friendTrackStore0=0;
-	      friendTrackStore1=0;
-	    }
-	  }
+	Double_t sizeAll=GetTreeZipBytes("CosmicPairs");
+	Double_t sizeFriend=GetTreeZipBytes("CosmicPairs","friendTrack0.fPoints")+GetTreeZipBytes("CosmicPairs","friendTrack0.fCalibContainer");
+	if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
+	  friendTrackStore0=0;
+	  friendTrackStore1=0;
 	}
       }
       if(!fFillTree) return;
@@ -1377,17 +1387,9 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  friendTrackStore = (gRandom->Rndm()<1./fFriendDownscaling)? friendTrack:0;
 	}
 	if (fFriendDownscaling<=0){
-	  if (((*fTreeSRedirector)<<"highPt").GetTree()){
-	    TTree * tree = ((*fTreeSRedirector)<<"highPt").GetTree();
-	    if (tree){
-	      Double_t sizeAll=tree->GetZipBytes();
-	      TBranch * br= tree->GetBranch("friendTrack.fPoints");
-	      Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	      br= tree->GetBranch("friendTrack.fCalibContainer");
-	      if (br) sizeFriend+=br->GetZipBytes();
-	      if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) friendTrackStore=0;
-	    }
-	  }
+	  Double_t sizeAll=GetTreeZipBytes("highPt");
+	  Double_t sizeFriend=GetTreeZipBytes("highPt","friendTrack.fPoints")+GetTreeZipBytes("highPt","friendTrack.fCalibContainer");
+	  if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) friendTrackStore=0;
 	}
 
 
@@ -1989,19 +1991,11 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
 	}
       }
       if (fFriendDownscaling<=0){
-	if (((*fTreeSRedirector)<<"V0s").GetTree()){
-	  TTree * tree = ((*fTreeSRedirector)<<"V0s").GetTree();
-	  if (tree){
-	    Double_t sizeAll=tree->GetZipBytes();
-	    TBranch * br= tree->GetBranch("friendTrack0.fPoints");
-	    Double_t sizeFriend=(br!=NULL)?br->GetZipBytes():0;
-	    br= tree->GetBranch("friendTrack0.fCalibContainer");
-	    if (br) sizeFriend+=br->GetZipBytes();
-	    if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
-	      friendTrackStore0=0;
-	      friendTrackStore1=0;
-	    }
-	  }
+	Double_t sizeAll=GetTreeZipBytes("V0s");
+	Double_t sizeFriend=GetTreeZipBytes("V0s","friendTrack0.fPoints")+GetTreeZipBytes("V0s","friendTrack0.fCalibContainer");
+	if (sizeFriend*TMath::Abs(fFriendDownscaling)>sizeAll) {
+	  friendTrackStore0=0;
+	  friendTrackStore1=0;
 	}
       }
 
@@ -2556,6 +2550,12 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   // Called one at the end 
   // locally on working node
   //
+  if (fAsyncWriter) {
+    fAsyncWriter->Finish();
+    fTreeSRedirector = fAsyncWriter->GetOutput();
+    delete fAsyncWriter;
+    fAsyncWriter = NULL;
+  }
   Bool_t deleteTrees=kTRUE;
   if ((AliAnalysisManager::GetAnalysisManager()))
   {
@@ -2567,6 +2567,21 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   fTreeSRedirector=NULL;
 }
 
+//_____________________________________________________________________________
+Double_t AliAnalysisTaskFilteredTree::GetTreeZipBytes(const char *treeName, const char *branchName)
+{
+  //
+  // compressed size of an output tree or of one of its branches (friend downscaling)
+  // in asynchronous mode the trees belong to the writer thread, the size after the last written buffer is used
+  //
+  if (fAsyncWriter) return fAsyncWriter->GetZipBytes(treeName, branchName);
+  TTree * tree = ((*fTreeSRedirector)<<treeName).GetTree();
+  if (!tree) return 0;
+  if (!branchName) return tree->GetZipBytes();
+  TBranch * br= tree->GetBranch(branchName);
+  return (br!=NULL)?br->GetZipBytes():0;
+}
+
 //_____________________________________________________________________________
 void AliAnalysisTaskFilteredTree::Terminate(Option_t *) 
 {
@@ -2772,6 +2787,10 @@ void AliAnalysisTaskFilteredTree::ProcessITSTPCmatchOut(AliESDEvent *const esdEv
   //      
   //
   Int_t ntracksPropagated=0;
+  const Double_t kIndexMargin=1e-6;  // margin on the index window, the exact fast theta cut is applied below
+  // tracks with TPC information sorted on tgl at the TPC inner wall (same as vecMomR1(,5))
+  const std::vector<std::pair<Double_t,Int_t> > &tpcIndex=GetNearestTrackIndex(esdEvent,1,1);
+  std::vector<Int_t> candidates;
   AliExternalTrackParam extTrackDummy;
   AliESDtrack           esdTrackDummy; 
   AliExternalTrackParam itsAtTPC;
@@ -2798,7 +2817,13 @@ void AliAnalysisTaskFilteredTree::ProcessITSTPCmatchOut(AliESDEvent *const esdEv
     Int_t ncandidates1=0; // n candidates - rough + chi2 cut
     itsAtTPC=*(friendTrack0->GetITSOut());
     itsAtITSTPC=*(friendTrack0->GetITSOut());
-    for (Int_t iTrack1=0; iTrack1<ntracks; iTrack1++){
+    // only tracks inside the fast theta cut window are visited, in the order of the track index
+    candidates.clear();
+    std::vector<std::pair<Double_t,Int_t> >::const_iterator itIndex=std::lower_bound(tpcIndex.begin(),tpcIndex.end(),std::make_pair(vecMomR0(iTrack0,5)-dFastThetaCut-kIndexMargin,-1));
+    for (; itIndex!=tpcIndex.end() && itIndex->first<=vecMomR0(iTrack0,5)+dFastThetaCut+kIndexMargin; ++itIndex) candidates.push_back(itIndex->second);
+    std::sort(candidates.begin(),candidates.end());
+    for (UInt_t icand=0; icand<candidates.size(); icand++){
+      Int_t iTrack1=candidates[icand];
       AliESDtrack *track1 = esdEvent->GetTrack(iTrack1);   
       if(!track1) continue;
       if (!track1->IsOn(AliVTrack::kTPCin)) continue;
@@ -2907,6 +2932,9 @@ Int_t   AliAnalysisTaskFilteredTree::GetNearestTrack(const AliExternalTrackParam
   //   paramType = 0 - global track
   //               1 - track at inner wall of TPC
   //
+  // Only the tracks inside the tgl window of the per event index (GetNearestTrackIndex)
+  // are visited. They are checked in the order of the track index with the same cuts
+  // as in a loop over all tracks, hence the selected track is the same.
   //          
   if (trackMatch==NULL){
     ::Error("AliAnalysisTaskFilteredTree::GetNearestTrack","invalid track pointer");
@@ -2916,10 +2944,23 @@ Int_t   AliAnalysisTaskFilteredTree::GetNearestTrack(const AliExternalTrackParam
   const Double_t ktglCut=0.1;
   const Double_t kqptCut=0.4;
   const Double_t kAlphaCut=0.2;
+  const Double_t kIndexMargin=1e-6;  // margin on the index window, the exact tgl cut is applied below
+  //
+  // candidates ordered by the track index
+  std::vector<Int_t> candidates;
+  if (trackType>=0 && trackType<=2 && paramType>=0 && paramType<=1){
+    const std::vector<std::pair<Double_t,Int_t> > &index=GetNearestTrackIndex(event,trackType,paramType);
+    std::vector<std::pair<Double_t,Int_t> >::const_iterator it=std::lower_bound(index.begin(),index.end(),std::make_pair(trackMatch->GetTgl()-ktglCut-kIndexMargin,-1));
+    for (; it!=index.end() && it->first<=trackMatch->GetTgl()+ktglCut+kIndexMargin; ++it) candidates.push_back(it->second);
+    std::sort(candidates.begin(),candidates.end());
+  }else{
+    for (Int_t itrack=0; itrack<ntracks; itrack++) candidates.push_back(itrack);
+  }
   //
   Double_t chi2Min=100000;
   Int_t indexMin=-1;
-  for (Int_t itrack=0; itrack<ntracks; itrack++){
+  for (UInt_t icand=0; icand<candidates.size(); icand++){
+    Int_t itrack=candidates[icand];
     if (itrack==indexSkip) continue;
     AliESDtrack *ptrack=event->GetTrack(itrack);
     if (ptrack==NULL) continue;
@@ -2959,6 +3000,37 @@ Int_t   AliAnalysisTaskFilteredTree::GetNearestTrack(const AliExternalTrackParam
 
 }
 
+const std::vector<std::pair<Double_t,Int_t> > & AliAnalysisTaskFilteredTree::GetNearestTrackIndex(AliESDEvent *event, Int_t trackType, Int_t paramType){
+  //
+  // Index of the tracks of the event passing the trackType selection and having the
+  // parameters of paramType (see GetNearestTrack), as (tgl, track index) sorted on tgl.
+  // Built on first use in an event, invalidated by ResetNearestTrackIndex (called for
+  // every new event in UserExec) or if asked for another event.
+  // Kink daughters are kept in the index, users have to reject them themselves.
+  //
+  if (event!=fNearestTrackIndexEvent){
+    for (Int_t itype=0; itype<3; itype++) for (Int_t iparam=0; iparam<2; iparam++) fNearestTrackIndexBuilt[itype][iparam]=kFALSE;
+    fNearestTrackIndexEvent=event;
+  }
+  std::vector<std::pair<Double_t,Int_t> > &index=fNearestTrackIndex[trackType][paramType];
+  if (fNearestTrackIndexBuilt[trackType][paramType]) return index;
+  index.clear();
+  Int_t ntracks=event->GetNumberOfTracks();
+  for (Int_t itrack=0; itrack<ntracks; itrack++){
+    AliESDtrack *ptrack=event->GetTrack(itrack);
+    if (ptrack==NULL) continue;
+    if (trackType==0 && (ptrack->IsOn(0x1)==kFALSE || ptrack->IsOn(0x10)==kTRUE))  continue;
+    if (trackType==1 && (ptrack->IsOn(0x10)==kFALSE))   continue;
+    if (trackType==2 && (ptrack->IsOn(0x1)==kFALSE || ptrack->IsOn(0x10)==kFALSE)) continue;
+    const AliExternalTrackParam * track=(paramType==0) ? ptrack : ptrack->GetInnerParam();
+    if (track==NULL) continue;
+    index.push_back(std::make_pair(track->GetTgl(),itrack));
+  }
+  std::sort(index.begin(),index.end());
+  fNearestTrackIndexBuilt[trackType][paramType]=kTRUE;
+  return index;
+}
+
 
 void  AliAnalysisTaskFilteredTree::SetDefaultAliasesV0(TTree *tree){
   //
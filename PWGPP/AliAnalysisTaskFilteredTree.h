@@ -28,9 +28,12 @@ class TList;
 class TObjArray;
 class TTree;
 class TTreeSRedirector;
+class AliAsyncTreeWriter;
 class TParticle;
 class TH3D;
 #include <string>
+#include <vector>
+#include <utility>
 
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
@@ -114,9 +117,16 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   void SetFillTrees(Bool_t filltree) { fFillTree = filltree ;}
   Bool_t GetFillTrees() { return fFillTree ;}
+  // compress and write the trees in a separate thread, buffers of eventsPerBuffer events, at most maxQueued waiting for the writer
+  // (enables ROOT thread safety for the whole process, see AliAsyncTreeWriter)
+  void SetAsyncOutput(Int_t eventsPerBuffer=100, Int_t maxQueued=2) { fAsyncEventsPerBuffer = eventsPerBuffer; fAsyncMaxQueued = maxQueued; }
+  Int_t GetAsyncOutput() const { return fAsyncEventsPerBuffer; }
 
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
   Int_t   GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType,  AliExternalTrackParam & paramNearest);
+  const std::vector<std::pair<Double_t,Int_t> > & GetNearestTrackIndex(AliESDEvent *event, Int_t trackType, Int_t paramType);
+  void    ResetNearestTrackIndex() { fNearestTrackIndexEvent=NULL; }
+  Double_t GetTreeZipBytes(const char *treeName, const char *branchName=0);
   static void SetDefaultAliasesV0(TTree *treeV0);
   static void SetDefaultAliasesHighPt(TTree *treeV0);
   Int_t GetMCInfoTrack(Int_t label,   std::map<std::string,float> &trackInfoF, std::map<std::string,TObject*> &trackInfoO);  //TODO- test before enabling
@@ -143,6 +153,9 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   EAnalysisMode fAnalysisMode;   // analysis mode TPC only, TPC + ITS
 
   TTreeSRedirector* fTreeSRedirector;      //! temp tree to dump output
+  AliAsyncTreeWriter* fAsyncWriter;        //! writer thread of the trees in asynchronous mode
+  Int_t fAsyncEventsPerBuffer;             // >0: asynchronous output, number of events per buffer
+  Int_t fAsyncMaxQueued;                   // asynchronous output, maximal number of buffers waiting for the writer
 
   TString fCentralityEstimator;     // use centrality can be "VOM" (default), "FMD", "TRK", "TKL", "CL0", "CL1", "V0MvsFMD", "TKLvsV0M", "ZEMvsZDC"
 
@@ -174,10 +187,15 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TH3D* fPtResCentPtTPCITS; //! sigma(pt)/pt vs Cent vs Pt for prim. TPC+ITS tracks
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
+  //
+  // per event index of the candidates for GetNearestTrack, per (trackType, paramType) sorted on tgl
+  std::vector<std::pair<Double_t,Int_t> > fNearestTrackIndex[3][2]; //! (tgl, track index) of candidates
+  Bool_t fNearestTrackIndexBuilt[3][2];                              //! index built for the current event
+  AliESDEvent *fNearestTrackIndexEvent;                              //! event the index belongs to
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 3); // example of analysis
 };
 
 #endif
@@ -0,0 +1,325 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include <vector>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+#include "RVersion.h"
+#include "TROOT.h"
+#include "TClass.h"
+#include "TMemFile.h"
+#include "TTree.h"
+#include "TBranchElement.h"
+#include "TLeaf.h"
+#include "TStopwatch.h"
+#include "TTreeStream.h"
+
+#include "AliLog.h"
+#include "AliAsyncTreeWriter.h"
+
+ClassImp(AliAsyncTreeWriter)
+
+// staging streams of one buffer, the trees are kept in an uncompressed memory file
+struct AliAsyncTreeWriter::Buffer {
+  TMemFile         *fFile;
+  TTreeSRedirector *fStream;
+};
+
+// writer thread and the queue of buffers waiting for it
+struct AliAsyncTreeWriter::Worker {
+  std::thread              fThread;
+  std::mutex               fMutex;
+  std::condition_variable  fNotEmpty;   // a buffer was queued or the writer has to stop
+  std::condition_variable  fNotFull;    // the writer took a buffer from the queue
+  std::deque<Buffer*>      fQueue;
+  Bool_t                   fStop;
+  std::set<std::string>    fErrors;     // unsupported branches, reported by Finish()
+  Worker() : fThread(), fMutex(), fNotEmpty(), fNotFull(), fQueue(), fStop(kFALSE), fErrors() {}
+};
+
+//_____________________________________________________________________________
+AliAsyncTreeWriter::AliAsyncTreeWriter(TTreeSRedirector *output, Int_t eventsPerBuffer, Int_t maxQueued) :
+  TObject(),
+  fOutput(output),
+  fStream(0),
+  fBuffer(0),
+  fWorker(0),
+  fEventsPerBuffer(eventsPerBuffer>0 ? eventsPerBuffer : 1),
+  fMaxQueued(maxQueued>0 ? maxQueued : 1),
+  fNEvents(0),
+  fNBuffers(0),
+  fNWaits(0),
+  fWaitTime(0),
+  fWriteTime(0),
+  fOutputTrees(),
+  fZipBytes()
+{
+  //
+  // Constructor, starts the writer thread filling the streams of output.
+  // The writer thread uses ROOT (I/O, TClass) concurrently with the event
+  // loop, hence ROOT thread safety is enabled for the whole process.
+  //
+  if (!fOutput) return;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+  AliInfo("enabling ROOT thread safety for the writer thread");
+  ROOT::EnableThreadSafety();
+#endif
+  fBuffer = NewBuffer();
+  fStream = fBuffer->fStream;
+  fWorker = new Worker;
+  fWorker->fThread = std::thread(&AliAsyncTreeWriter::Run, this);
+}
+
+//_____________________________________________________________________________
+AliAsyncTreeWriter::~AliAsyncTreeWriter()
+{
+  //
+  // Destructor, writes the pending buffers if Finish() was not called
+  //
+  Finish();
+}
+
+//_____________________________________________________________________________
+TTreeSRedirector* AliAsyncTreeWriter::Commit()
+{
+  //
+  // To be called at the end of each event. Once the current buffer holds
+  // fEventsPerBuffer events it is queued for the writer and a new one is
+  // started. Returns the streams to be used for the next event.
+  //
+  if (!fBuffer) return fStream;
+  if (++fNEvents < fEventsPerBuffer) return fStream;
+  Enqueue(fBuffer);
+  fBuffer = NewBuffer();
+  fStream = fBuffer->fStream;
+  fNEvents = 0;
+  return fStream;
+}
+
+//_____________________________________________________________________________
+void AliAsyncTreeWriter::Finish()
+{
+  //
+  // Queue the last buffer and wait until everything is written. Afterwards
+  // the output streams can be used directly again.
+  //
+  if (!fWorker) return;
+  Enqueue(fBuffer);
+  fBuffer = 0;
+  fStream = 0;
+  {
+    std::lock_guard<std::mutex> lock(fWorker->fMutex);
+    fWorker->fStop = kTRUE;
+  }
+  fWorker->fNotEmpty.notify_all();
+  if (fWorker->fThread.joinable()) fWorker->fThread.join();
+  // the writer thread does not log, report what it could not write
+  for (std::set<std::string>::const_iterator it=fWorker->fErrors.begin(); it!=fWorker->fErrors.end(); ++it) {
+    AliError(it->c_str());
+  }
+  delete fWorker;
+  fWorker = 0;
+  Print();
+}
+
+//_____________________________________________________________________________
+Long64_t AliAsyncTreeWriter::GetZipBytes(const char *treeName, const char *branchName)
+{
+  //
+  // Compressed size of an output tree, or of one of its branches, after the
+  // last written buffer. The first request registers the tree (branch), 0 is
+  // returned until the writer updated it.
+  //
+  std::string key(treeName);
+  if (branchName) {
+    key += '/';
+    key += branchName;
+  }
+  std::unique_lock<std::mutex> lock;
+  if (fWorker) lock = std::unique_lock<std::mutex>(fWorker->fMutex);
+  return fZipBytes[key];
+}
+
+//_____________________________________________________________________________
+void AliAsyncTreeWriter::Print(Option_t *) const
+{
+  //
+  // Print the statistics of the writer
+  //
+  Printf("AliAsyncTreeWriter: %lld buffers of up to %d events written in %.2f s, the event loop waited %lld times for %.2f s",
+         fNBuffers, fEventsPerBuffer, fWriteTime, fNWaits, fWaitTime);
+}
+
+//_____________________________________________________________________________
+AliAsyncTreeWriter::Buffer* AliAsyncTreeWriter::NewBuffer()
+{
+  //
+  // New staging buffer. The TTreeSRedirector creates its trees in the
+  // current directory, i.e. in the memory file.
+  //
+  TDirectory *backup = gDirectory;
+  Buffer *buffer = new Buffer;
+  buffer->fFile = new TMemFile(Form("AliAsyncTreeWriter_%p.root", (void*)buffer), "RECREATE", "", 0);
+  buffer->fFile->cd();
+  buffer->fStream = new TTreeSRedirector();
+  if (backup) backup->cd();
+  else gROOT->cd();
+  return buffer;
+}
+
+//_____________________________________________________________________________
+void AliAsyncTreeWriter::Enqueue(Buffer *buffer)
+{
+  //
+  // Hand a buffer to the writer, waiting while fMaxQueued buffers are pending
+  //
+  if (!buffer) return;
+  std::unique_lock<std::mutex> lock(fWorker->fMutex);
+  if ((Int_t)fWorker->fQueue.size() >= fMaxQueued) {
+    TStopwatch timer;
+    while ((Int_t)fWorker->fQueue.size() >= fMaxQueued) fWorker->fNotFull.wait(lock);
+    fWaitTime += timer.RealTime();
+    fNWaits++;
+  }
+  fWorker->fQueue.push_back(buffer);
+  fWorker->fNotEmpty.notify_one();
+}
+
+//_____________________________________________________________________________
+void AliAsyncTreeWriter::Run()
+{
+  //
+  // Writer thread: write the queued buffers in order until Finish()
+  //
+  for (;;) {
+    Buffer *buffer = 0;
+    {
+      std::unique_lock<std::mutex> lock(fWorker->fMutex);
+      while (fWorker->fQueue.empty() && !fWorker->fStop) fWorker->fNotEmpty.wait(lock);
+      if (fWorker->fQueue.empty()) return;
+      buffer = fWorker->fQueue.front();
+      fWorker->fQueue.pop_front();
+    }
+    fWorker->fNotFull.notify_one();
+    WriteBuffer(buffer);
+  }
+}
+
+//_____________________________________________________________________________
+void AliAsyncTreeWriter::WriteBuffer(Buffer *buffer)
+{
+  //
+  // Replay the entries of the staging trees into the output streams, tree by
+  // tree in the order of creation. Basic types are taken from the leaves and
+  // objects from the branches, in the order of the original << chain, hence
+  // the output trees get the same branches as if the task had streamed into
+  // them directly.
+  //
+  TStopwatch timer;
+  TIter next(buffer->fFile->GetList());
+  while (TObject *obj = next()) {
+    TTree *tree = dynamic_cast<TTree*>(obj);
+    if (!tree) continue;
+    Long64_t entries = tree->GetEntries();
+    if (entries<=0) continue;
+    // the branches still point to the objects of the event loop, read into own ones
+    tree->ResetBranchAddresses();
+
+    TObjArray *branches = tree->GetListOfBranches();
+    Int_t nBranches = branches->GetEntriesFast();
+    std::vector<TString> names(nBranches);
+    std::vector<TString> types(nBranches);   // type name of the leaf, empty for objects
+    std::vector<TClass*> classes(nBranches, (TClass*)0);
+    for (Int_t i=0; i<nBranches; i++) {
+      TBranch *branch = (TBranch*)branches->At(i);
+      names[i] = TString(branch->GetName())+"=";
+      if (branch->InheritsFrom(TBranchElement::Class())) {
+        classes[i] = TClass::GetClass(((TBranchElement*)branch)->GetClassName());
+      } else {
+        TLeaf *leaf = (TLeaf*)branch->GetListOfLeaves()->At(0);
+        if (leaf) types[i] = leaf->GetTypeName();
+      }
+    }
+
+    TTreeStream &stream = (*fOutput)<<tree->GetName();
+    for (Long64_t entry=0; entry<entries; entry++) {
+      tree->GetEntry(entry);
+      for (Int_t i=0; i<nBranches; i++) {
+        TBranch *branch = (TBranch*)branches->At(i);
+        if (classes[i]) {
+          void *object = ((TBranchElement*)branch)->GetObject();
+          stream<<names[i].Data()<<(TObject*)classes[i]->DynamicCast(TObject::Class(), object);
+          continue;
+        }
+        TLeaf *leaf = (TLeaf*)branch->GetListOfLeaves()->At(0);
+        if (!leaf) continue;
+        void *value = leaf->GetValuePointer();
+        stream<<names[i].Data();
+        if      (types[i]=="Double_t")  stream<<*(Double_t*)value;
+        else if (types[i]=="Float_t")   stream<<*(Float_t*)value;
+        else if (types[i]=="Int_t")     stream<<*(Int_t*)value;
+        else if (types[i]=="UInt_t")    stream<<*(UInt_t*)value;
+        else if (types[i]=="Long64_t")  stream<<*(Long64_t*)value;
+        else if (types[i]=="ULong64_t") stream<<*(ULong64_t*)value;
+        else if (types[i]=="Short_t")   stream<<*(Short_t*)value;
+        else if (types[i]=="UShort_t")  stream<<*(UShort_t*)value;
+        else if (types[i]=="Char_t")    stream<<*(Char_t*)value;
+        else if (types[i]=="UChar_t")   stream<<*(UChar_t*)value;
+        else if (entry==0) fWorker->fErrors.insert(TString::Format("%s: branch %s of type %s not supported", tree->GetName(), branch->GetName(), types[i].Data()).Data());
+      }
+      stream<<"\n";
+    }
+    fOutputTrees[tree->GetName()] = stream.GetTree();
+  }
+  UpdateZipBytes();
+
+  // closing the staging streams writes the (reset) tree headers to the memory file
+  delete buffer->fStream;
+  buffer->fFile->Close();
+  delete buffer->fFile;
+  delete buffer;
+  fNBuffers++;
+  fWriteTime += timer.RealTime();
+}
+
+//_____________________________________________________________________________
+void AliAsyncTreeWriter::UpdateZipBytes()
+{
+  //
+  // Update the compressed sizes requested by GetZipBytes() from the output trees
+  //
+  std::lock_guard<std::mutex> lock(fWorker->fMutex);
+  for (std::map<std::string,Long64_t>::iterator it=fZipBytes.begin(); it!=fZipBytes.end(); ++it) {
+    std::string treeName = it->first;
+    std::string branchName;
+    size_t separator = treeName.find('/');
+    if (separator!=std::string::npos) {
+      branchName = treeName.substr(separator+1);
+      treeName.resize(separator);
+    }
+    std::map<std::string,TTree*>::const_iterator tree = fOutputTrees.find(treeName);
+    if (tree==fOutputTrees.end() || !tree->second) continue;
+    if (branchName.empty()) {
+      it->second = tree->second->GetZipBytes();
+    } else {
+      TBranch *branch = tree->second->GetBranch(branchName.c_str());
+      it->second = branch ? branch->GetZipBytes() : 0;
+    }
+  }
+}
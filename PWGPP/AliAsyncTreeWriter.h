@@ -0,0 +1,90 @@
+#ifndef ALIASYNCTREEWRITER_H
+#define ALIASYNCTREEWRITER_H
+
+//------------------------------------------------------------------------------
+// Asynchronous output of TTreeSRedirector based skims.
+//
+// The task streams its entries into a staging TTreeSRedirector (GetStream())
+// instead of the one writing the output file. The staging trees live in an
+// uncompressed TMemFile, filling them only serializes the entries. Every
+// fEventsPerBuffer events (Commit()) the staging buffer is queued and a new
+// one is started. A writer thread replays the queued entries, in the same
+// order, into the streams of the output redirector, where the baskets are
+// compressed and written. At most fMaxQueued buffers wait for the writer;
+// if the queue is full, Commit() blocks until the writer caught up. The time
+// spent waiting is accumulated (GetWaitTime()).
+//
+// Usage in a task:
+//   UserCreateOutputObjects: fWriter = new AliAsyncTreeWriter(fTreeSRedirector);
+//                            fTreeSRedirector = fWriter->GetStream();
+//   UserExec (end):          fTreeSRedirector = fWriter->Commit();
+//   FinishTaskOutput:        fWriter->Finish(); fTreeSRedirector = fWriter->GetOutput();
+//
+// The output trees must not be accessed while the writer is running, their
+// compressed sizes are available through GetZipBytes(). Branches of types the
+// writer cannot replay are reported by Finish().
+//
+// The writer thread uses ROOT concurrently with the event loop, therefore the
+// constructor calls ROOT::EnableThreadSafety(). This holds for the rest of the
+// process (e.g. gDirectory becomes thread local), the writer should only be
+// created if asynchronous output is requested.
+//------------------------------------------------------------------------------
+
+#include "TObject.h"
+
+#include <map>
+#include <string>
+
+class TTree;
+class TTreeSRedirector;
+
+class AliAsyncTreeWriter : public TObject {
+ public:
+  AliAsyncTreeWriter(TTreeSRedirector *output=0, Int_t eventsPerBuffer=100, Int_t maxQueued=2);
+  virtual ~AliAsyncTreeWriter();
+
+  TTreeSRedirector* GetStream() const { return fStream; }
+  TTreeSRedirector* GetOutput() const { return fOutput; }
+  TTreeSRedirector* Commit();
+  void              Finish();
+  Long64_t          GetZipBytes(const char *treeName, const char *branchName=0);
+
+  Int_t    GetEventsPerBuffer() const { return fEventsPerBuffer; }
+  Int_t    GetMaxQueued() const       { return fMaxQueued; }
+  Long64_t GetNBuffers() const        { return fNBuffers; }
+  Long64_t GetNWaits() const          { return fNWaits; }
+  Double_t GetWaitTime() const        { return fWaitTime; }
+  Double_t GetWriteTime() const       { return fWriteTime; }
+  virtual void Print(Option_t *option="") const;
+
+ private:
+  struct Worker;
+  struct Buffer;
+
+  AliAsyncTreeWriter(const AliAsyncTreeWriter&);            // not implemented
+  AliAsyncTreeWriter& operator=(const AliAsyncTreeWriter&); // not implemented
+
+  Buffer*  NewBuffer();
+  void     Enqueue(Buffer *buffer);
+  void     Run();
+  void     WriteBuffer(Buffer *buffer);
+  void     UpdateZipBytes();
+
+  TTreeSRedirector*  fOutput;           //! output streams, used by the writer thread only
+  TTreeSRedirector*  fStream;           //! staging streams of the current buffer
+  Buffer*            fBuffer;           //! current buffer
+  Worker*            fWorker;           //! writer thread and queue
+  Int_t              fEventsPerBuffer;  // number of events per buffer
+  Int_t              fMaxQueued;        // maximal number of buffers waiting for the writer
+  Int_t              fNEvents;          //! events in the current buffer
+  Long64_t           fNBuffers;         //! number of buffers written
+  Long64_t           fNWaits;           //! number of times Commit() waited for the writer
+  Double_t           fWaitTime;         //! time Commit() waited for the writer (s)
+  Double_t           fWriteTime;        //! time spent by the writer thread (s)
+  std::map<std::string,TTree*>    fOutputTrees; //! output trees filled so far, by name
+  std::map<std::string,Long64_t>  fZipBytes;    //! compressed size of the requested trees/branches
+
+  ClassDef(AliAsyncTreeWriter, 1); // asynchronous writer of TTreeSRedirector streams
+};
+
+#endif
@@ -17,6 +17,8 @@
 
 #include <TChain.h>
 #include <TFile.h>
+#include <TStopwatch.h>
+#include <TSystem.h>
  
 #include "AliTender.h"
 #include "AliTenderSupply.h"
@@ -41,7 +43,13 @@ AliTender::AliTender():
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fOCDBSnapshotDir(),
+           fCreateOCDBSnapshot(kFALSE),
+           fSnapshotPending(kFALSE),
+           fUsingSnapshot(kFALSE),
+           fInitTime(),
+           fRunInitTime()
 {
 // Dummy constructor
 }
@@ -58,7 +66,13 @@ AliTender::AliTender(const char* name):
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fOCDBSnapshotDir(),
+           fCreateOCDBSnapshot(kFALSE),
+           fSnapshotPending(kFALSE),
+           fUsingSnapshot(kFALSE),
+           fInitTime(),
+           fRunInitTime()
 {
 // Default constructor
   DefineOutput(1,  AliESDEvent::Class());
@@ -123,13 +137,25 @@ void AliTender::ConnectInputData(Option_t* option)
     fCDB->SetDefaultStorage(fDefaultStorage);
     // Unlock CDB
     fCDBkey = fCDB->SetLock(kFALSE, fCDBkey);
-    if(run){ fCDB->SetRun(fRun); }
+    if(run){ fCDB->SetRun(fRun); SetupOCDBSnapshot(); }
     // Lock CDB
     fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
+  } else if (fOCDBSnapshotDir.Length()) {
+    AliWarning("OCDB snapshots require SetHandleOCDB(kTRUE), not used");
+  }
+  Int_t nsupplies = fSupplies ? fSupplies->GetEntriesFast() : 0;
+  fInitTime.Set(nsupplies);
+  fInitTime.Reset();
+  fRunInitTime.Set(nsupplies);
+  fRunInitTime.Reset();
+  TStopwatch timer;
+  for (Int_t i=0; i<nsupplies; i++) {
+    AliTenderSupply *supply = (AliTenderSupply*)fSupplies->At(i);
+    if (!supply) continue;
+    timer.Start(kTRUE);
+    supply->Init();
+    fInitTime[i] = timer.RealTime();
   }
-  TIter next(fSupplies);
-  AliTenderSupply *supply;
-  while ((supply=(AliTenderSupply*)next())) supply->Init();
 }
 
 //______________________________________________________________________________
@@ -166,13 +192,31 @@ void AliTender::UserExec(Option_t* option)
       // Unlock CDB
       fCDBkey = fCDB->SetLock(kFALSE, fCDBkey);
       fCDB->SetRun(fRun);
+      SetupOCDBSnapshot();
       // Lock CDB
       fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
     } 
   }
-  TIter next(fSupplies);
-  AliTenderSupply *supply;
-  while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+  Int_t nsupplies = fSupplies ? fSupplies->GetEntriesFast() : 0;
+  if (fRunChanged) {
+    // Supplies load their run dependent objects here: time them
+    if (fRunInitTime.GetSize() < nsupplies) fRunInitTime.Set(nsupplies);
+    TStopwatch timer;
+    for (Int_t i=0; i<nsupplies; i++) {
+      AliTenderSupply *supply = (AliTenderSupply*)fSupplies->At(i);
+      if (!supply) continue;
+      timer.Start(kTRUE);
+      supply->ProcessEvent();
+      fRunInitTime[i] = timer.RealTime();
+    }
+    if (fSnapshotPending) WriteOCDBSnapshot();
+    PrintSupplyTimes();
+  } else {
+    for (Int_t i=0; i<nsupplies; i++) {
+      AliTenderSupply *supply = (AliTenderSupply*)fSupplies->At(i);
+      if (supply) supply->ProcessEvent();
+    }
+  }
   fRunChanged = kFALSE;
 
   if (TObject::TestBit(kCheckEventSelection)) fESDhandler->CheckSelectionMask();
@@ -187,3 +231,70 @@ void AliTender::SetDefaultCDBStorage(const char *dbString)
 // Set default CDB storage
    fDefaultStorage = dbString;
 }
+
+//______________________________________________________________________________
+TString AliTender::GetOCDBSnapshotFileName(Int_t run) const
+{
+// Name of the OCDB snapshot file of a run
+   TString dir = fOCDBSnapshotDir;
+   gSystem->ExpandPathName(dir);
+   return TString::Format("%s/OCDB_%d.root", dir.Data(), run);
+}
+
+//______________________________________________________________________________
+void AliTender::SetupOCDBSnapshot()
+{
+// Serve the current run from its snapshot if it exists, otherwise from the
+// storage, and schedule writing of the snapshot if requested.
+// To be called with the CDB manager unlocked.
+   fSnapshotPending = kFALSE;
+   fUsingSnapshot = kFALSE;
+   if (!fOCDBSnapshotDir.Length() || !fRun) return;
+   fCDB->UnsetSnapshotMode();
+   TString fname = GetOCDBSnapshotFileName(fRun);
+   if (!gSystem->AccessPathName(fname)) {
+      if (fCDB->SetSnapshotMode(fname)) {
+         fUsingSnapshot = kTRUE;
+         AliInfo(Form("Using OCDB snapshot %s", fname.Data()));
+         return;
+      }
+      AliWarning(Form("Cannot use OCDB snapshot %s, using the storage", fname.Data()));
+      fCDB->UnsetSnapshotMode();
+   }
+   fSnapshotPending = fCreateOCDBSnapshot;
+}
+
+//______________________________________________________________________________
+void AliTender::WriteOCDBSnapshot()
+{
+// Write the objects loaded for the current run to its snapshot file. Each job
+// writes a temporary file and renames it, such that concurrent jobs never
+// see a partial snapshot.
+   fSnapshotPending = kFALSE;
+   TString fname = GetOCDBSnapshotFileName(fRun);
+   if (!gSystem->AccessPathName(fname)) return; // written by another job meanwhile
+   TString dir = gSystem->DirName(fname);
+   gSystem->mkdir(dir, kTRUE);
+   TString tmp = TString::Format("%s.%d.tmp", fname.Data(), gSystem->GetPid());
+   fCDB->DumpToSnapshotFile(tmp, kTRUE);
+   if (gSystem->AccessPathName(tmp) || gSystem->Rename(tmp, fname)) {
+      AliWarning(Form("Could not write OCDB snapshot %s", fname.Data()));
+      gSystem->Unlink(tmp);
+      return;
+   }
+   AliInfo(Form("Wrote OCDB snapshot %s", fname.Data()));
+}
+
+//______________________________________________________________________________
+void AliTender::PrintSupplyTimes() const
+{
+// Report the time spent by each supply in Init() and in the first event of the run
+   AliInfo(Form("Run %d, OCDB from %s:", fRun, fUsingSnapshot ? "snapshot" : "storage"));
+   Int_t nsupplies = fSupplies ? fSupplies->GetEntriesFast() : 0;
+   for (Int_t i=0; i<nsupplies; i++) {
+      AliTenderSupply *supply = (AliTenderSupply*)fSupplies->At(i);
+      if (!supply) continue;
+      AliInfo(Form("   %-30s Init: %8.3f s, first event of run: %8.3f s", supply->GetName(),
+                   i < fInitTime.GetSize() ? fInitTime[i] : 0., i < fRunInitTime.GetSize() ? fRunInitTime[i] : 0.));
+   }
+}
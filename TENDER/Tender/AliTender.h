@@ -17,6 +17,10 @@
 #include "AliAnalysisTaskSE.h"
 #endif
 
+#ifndef ROOT_TArrayD
+#include "TArrayD.h"
+#endif
+
 // #ifndef ALIESDINPUTHANDLER_H
 // #include "AliESDInputHandler.h"
 // #endif
@@ -43,10 +47,21 @@ private:
   AliESDEvent              *fESD;            //! Pointer to current ESD event
   TObjArray                *fSupplies;       // Array of tender supplies
   TObjArray                *fCDBSettings;    // Array with CDB configuration
+  TString                   fOCDBSnapshotDir;    // Directory of the per-run OCDB snapshots
+  Bool_t                    fCreateOCDBSnapshot; // Write the snapshot of a run if missing
+  Bool_t                    fSnapshotPending;    //! Snapshot of the current run to be written
+  Bool_t                    fUsingSnapshot;      //! Current run is served from a snapshot
+  TArrayD                   fInitTime;           //! Time [s] spent in Init() per supply
+  TArrayD                   fRunInitTime;        //! Time [s] spent in the first event of the run per supply
   
   AliTender(const AliTender &other);
   AliTender& operator=(const AliTender &other);
 
+  TString                   GetOCDBSnapshotFileName(Int_t run) const;
+  void                      SetupOCDBSnapshot();
+  void                      WriteOCDBSnapshot();
+  void                      PrintSupplyTimes() const;
+
 public:  
   AliTender();
   AliTender(const char *name);
@@ -68,6 +83,19 @@ public:
    */
   void 			    SetHandleOCDB(Bool_t doHandle) { fHandleCDB = doHandle; }
   void SetESDhandler(AliESDInputHandler*esdH) {fESDhandler = esdH;}
+  /**
+   * Serve the OCDB objects of each run from a local snapshot file
+   * <dir>/OCDB_<run>.root (AliCDBManager snapshot mode). The directory
+   * should be node-local and is shared read-only by all jobs. Requires
+   * SetHandleOCDB(kTRUE). Paths with a specific storage are not taken
+   * from the snapshot.
+   * @param[in] dir    Snapshot directory (empty: no snapshot, the default)
+   * @param[in] create If true, a missing snapshot is written from the objects
+   *                   loaded in the first event of the run, such that it is
+   *                   built once per production
+   */
+  void                      SetOCDBSnapshot(const char *dir, Bool_t create=kTRUE) {fOCDBSnapshotDir = dir; fCreateOCDBSnapshot = create;}
+  const char               *GetOCDBSnapshotDir() const {return fOCDBSnapshotDir.Data();}
 
   // Run control
   virtual void              ConnectInputData(Option_t *option = "");
@@ -75,6 +103,6 @@ public:
 //  virtual Bool_t            Notify() {return kTRUE;}
   virtual void              UserExec(Option_t *option);
     
-  ClassDef(AliTender,4)  // Class describing the tender car for ESD analysis
+  ClassDef(AliTender,5)  // Class describing the tender car for ESD analysis
 };
 #endif